@@ -0,0 +1,37 @@
+// Shared setup for the benchmarks. Each one is a single translation unit that includes clay.h with CLAY_IMPLEMENTATION, so
+// that the same source can be built against the clay.h from another revision to compare the two.
+#define CLAY_IMPLEMENTATION
+#include "clay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double Bench_NowMilliseconds(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+}
+
+// Monospaced, so that the layout doesn't depend on anything outside of clay.h
+static Clay_Dimensions Bench_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData) {
+    return CLAY__INIT(Clay_Dimensions) { text.length * config->fontSize * 0.6f, (float)config->fontSize };
+}
+
+static void Bench_HandleError(Clay_ErrorData errorData) {
+    fprintf(stderr, "%.*s\n", errorData.errorText.length, errorData.errorText.chars);
+    exit(1);
+}
+
+static void Bench_Initialize(int32_t maxElementCount, Clay_Dimensions layoutDimensions) {
+    Clay_SetMaxElementCount(maxElementCount);
+    Clay_SetMaxMeasureTextCacheWordCount(maxElementCount * 32);
+    uint64_t memorySize = Clay_MinMemorySize();
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(memorySize, malloc(memorySize)), layoutDimensions, CLAY__INIT(Clay_ErrorHandler) { Bench_HandleError });
+    Clay_SetMeasureTextFunction(Bench_MeasureText, 0);
+}
+
+// The size to run at comes from the command line, so that every size gets a process, and a context, of its own
+static int32_t Bench_SizeArgument(int argc, char **argv, int32_t defaultSize) {
+    return argc > 1 ? atoi(argv[1]) : defaultSize;
+}
@@ -0,0 +1,42 @@
+// Lays out a single row that's far too narrow for its children, so that every frame the sizing pass has to compress them
+// all down towards their minimum widths. The children are a mix of fit and grow sizing with and without minimums, around a
+// text element each. Run with the number of children, and it prints the fastest of a number of frames.
+#include "bench.h"
+
+static char text[64];
+
+int main(int argc, char **argv) {
+    int32_t childCount = Bench_SizeArgument(argc, argv, 1000);
+    int32_t frameCount = 20;
+    // Squeezed this narrow, the text wraps onto a line per word, and each line takes a render command
+    Bench_Initialize(childCount * 20 + 100, CLAY__INIT(Clay_Dimensions) { 1000, 800 });
+    Clay_SetCullingEnabled(false);
+    memset(text, 'a', sizeof(text) - 1);
+    for (int i = 3; i < (int)sizeof(text) - 1; i += 4) {
+        text[i] = ' ';
+    }
+    double fastest = 1e9;
+    for (int32_t frame = 0; frame < frameCount; ++frame) {
+        // The same children every frame, with the same seed
+        srand(7);
+        double start = Bench_NowMilliseconds();
+        Clay_BeginLayout();
+        CLAY(CLAY_ID("Row"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(childCount * 12.0f), CLAY_SIZING_FIXED(30) }, .childGap = 1 })) {
+            for (int32_t i = 0; i < childCount; ++i) {
+                int32_t textLength = 2 + rand() % 40;
+                int32_t sizingType = rand() % 3;
+                float minWidth = (float)(rand() % 60);
+                Clay_SizingAxis width = sizingType == 0 ? CLAY_SIZING_FIT(0) : sizingType == 1 ? CLAY_SIZING_FIT(minWidth) : CLAY_SIZING_GROW(minWidth);
+                Clay_String childText = { .length = textLength, .chars = text };
+                CLAY(CLAY_RECTANGLE({ .color = { 255, 255, 255, 255 } }), CLAY_LAYOUT({ .sizing = { width }, .padding = { 2, 2 } })) {
+                    CLAY_TEXT(childText, CLAY_TEXT_CONFIG({ .fontSize = 12 }));
+                }
+            }
+        }
+        Clay_EndLayout();
+        double elapsed = Bench_NowMilliseconds() - start;
+        fastest = elapsed < fastest ? elapsed : fastest;
+    }
+    printf("compress_children %6d children: %9.3f ms per frame\n", childCount, fastest);
+    return 0;
+}
@@ -0,0 +1,60 @@
+// A grid of cells that each carry a rectangle, a custom, an image and a border config around a line of text, so that every
+// element has several configs to look through. At 1000 rows that's around 41k elements. Run with the number of rows, and it
+// prints the fastest of a number of frames for the whole of Clay_EndLayout, and per call for Clay__FindElementConfigWithType
+// asked for a border, image, scroll and text config on every element.
+#include "bench.h"
+
+#define GRID_COLUMNS 20
+
+static void DeclareGrid(int32_t rowCount) {
+    CLAY(CLAY_ID("Grid"), CLAY_SCROLL({ .vertical = true }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 2 })) {
+        for (int32_t row = 0; row < rowCount; ++row) {
+            CLAY(CLAY_IDI("Row", row), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0) }, .childGap = 2 })) {
+                for (int32_t column = 0; column < GRID_COLUMNS; ++column) {
+                    CLAY(CLAY_IDI("Cell", row * GRID_COLUMNS + column),
+                        CLAY_RECTANGLE({ .color = { 240, 240, 240, 255 } }),
+                        CLAY_CUSTOM_ELEMENT({ .customData = NULL }),
+                        CLAY_IMAGE({ .sourceDimensions = { 16, 16 } }),
+                        CLAY_BORDER_ALL({ 1, { 0, 0, 0, 255 } }),
+                        CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0) }, .padding = { 4, 4, 2, 2 } })) {
+                        CLAY_TEXT(CLAY_STRING("Cell"), CLAY_TEXT_CONFIG({ .fontSize = 12 }));
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int32_t rowCount = Bench_SizeArgument(argc, argv, 1000);
+    int32_t frameCount = 20;
+    // Every cell has four configs, and the config arrays are sized by the element count
+    Bench_Initialize(rowCount * GRID_COLUMNS * 5 + 100, CLAY__INIT(Clay_Dimensions) { 1200, 800 });
+    Clay__ElementConfigType lookupTypes[] = { CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER, CLAY__ELEMENT_CONFIG_TYPE_IMAGE, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER, CLAY__ELEMENT_CONFIG_TYPE_TEXT };
+    double fastestEndLayout = 1e9, fastestLookup = 1e9;
+    uintptr_t found = 0;
+    for (int32_t frame = 0; frame < frameCount; ++frame) {
+        // Alternating the width by a pixel makes every frame go through the whole layout
+        Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1200.f + (float)(frame % 2), 800 });
+        Clay_BeginLayout();
+        DeclareGrid(rowCount);
+        double start = Bench_NowMilliseconds();
+        Clay_EndLayout();
+        double lookupStart = Bench_NowMilliseconds();
+        Clay_Context *context = Clay_GetCurrentContext();
+        for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+            Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+            for (int32_t type = 0; type < 4; ++type) {
+                found += (uintptr_t)Clay__FindElementConfigWithType(layoutElement, lookupTypes[type]).rectangleElementConfig;
+            }
+        }
+        double lookupEnd = Bench_NowMilliseconds();
+        fastestEndLayout = CLAY__MIN(fastestEndLayout, lookupStart - start);
+        fastestLookup = CLAY__MIN(fastestLookup, lookupEnd - lookupStart);
+    }
+    int32_t elementCount = Clay_GetCurrentContext()->layoutElements.length;
+    // The sum is printed so that the lookups can't be optimised away
+    printf("element_configs %5d rows, %6d elements: EndLayout %7.2f ms, FindElementConfigWithType %5.1f ns per call (%d)\n", rowCount, elementCount,
+        fastestEndLayout, fastestLookup * 1e6 / (elementCount * 4.0), (int)(found & 1));
+    return 0;
+}
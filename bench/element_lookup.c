@@ -0,0 +1,58 @@
+// Declares a flat list of elements with ids, then looks every one of them up by id in a shuffled order, and looks up as many
+// ids that were never declared. Run with the number of ids. It prints the fastest of a number of frames for each, per element.
+#include "bench.h"
+
+int main(int argc, char **argv) {
+    int32_t idCount = Bench_SizeArgument(argc, argv, 10000);
+    int32_t frameCount = 20, lookupRounds = 4;
+    Bench_Initialize(idCount + 100, CLAY__INIT(Clay_Dimensions) { 1200, 800 });
+    Clay_ElementId *declaredIds = (Clay_ElementId *)malloc(sizeof(Clay_ElementId) * idCount);
+    Clay_ElementId *missingIds = (Clay_ElementId *)malloc(sizeof(Clay_ElementId) * idCount);
+    for (int32_t i = 0; i < idCount; ++i) {
+        declaredIds[i] = Clay__HashString(CLAY_STRING("Item"), i, 0);
+        missingIds[i] = Clay__HashString(CLAY_STRING("Missing"), i, 0);
+    }
+    // Looked up in a different order to the one they were added in
+    uint32_t seed = 1;
+    for (int32_t i = idCount - 1; i > 0; --i) {
+        seed = seed * 1103515245u + 12345u;
+        int32_t j = (int32_t)((seed >> 8) % (uint32_t)(i + 1));
+        Clay_ElementId swap = declaredIds[i];
+        declaredIds[i] = declaredIds[j];
+        declaredIds[j] = swap;
+    }
+    double fastestDeclare = 1e9, fastestHit = 1e9, fastestMiss = 1e9;
+    uintptr_t found = 0;
+    for (int32_t frame = 0; frame < frameCount; ++frame) {
+        double start = Bench_NowMilliseconds();
+        Clay_BeginLayout();
+        CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+            for (int32_t i = 0; i < idCount; ++i) {
+                CLAY(CLAY_IDI("Item", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(10), CLAY_SIZING_FIXED(10) } })) {}
+            }
+        }
+        double declareEnd = Bench_NowMilliseconds();
+        Clay_EndLayout();
+        double hitStart = Bench_NowMilliseconds();
+        for (int32_t round = 0; round < lookupRounds; ++round) {
+            for (int32_t i = 0; i < idCount; ++i) {
+                found += (uintptr_t)Clay__GetHashMapItem(declaredIds[i].id)->layoutElement;
+            }
+        }
+        double missStart = Bench_NowMilliseconds();
+        for (int32_t round = 0; round < lookupRounds; ++round) {
+            for (int32_t i = 0; i < idCount; ++i) {
+                found += (uintptr_t)Clay__GetHashMapItem(missingIds[i].id)->layoutElement;
+            }
+        }
+        double missEnd = Bench_NowMilliseconds();
+        fastestDeclare = CLAY__MIN(fastestDeclare, declareEnd - start);
+        fastestHit = CLAY__MIN(fastestHit, missStart - hitStart);
+        fastestMiss = CLAY__MIN(fastestMiss, missEnd - missStart);
+    }
+    double lookupCount = (double)lookupRounds * idCount;
+    // The sum is printed so that the lookups can't be optimised away
+    printf("element_lookup %7d ids: declare %6.1f ns, hit %5.1f ns, miss %5.1f ns per element (%d)\n", idCount,
+        fastestDeclare * 1e6 / idCount, fastestHit * 1e6 / lookupCount, fastestMiss * 1e6 / lookupCount, (int)(found & 1));
+    return 0;
+}
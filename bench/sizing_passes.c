@@ -0,0 +1,58 @@
+// A dashboard: a sidebar and a scrolling grid of rows of twenty cells, each cell a rectangle around a line of text. At 1250
+// rows that's around 51k elements. Run with the number of rows, and it prints the fastest of a number of frames for the X and Y
+// sizing passes on their own, and for the whole of Clay_EndLayout.
+#include "bench.h"
+
+#define GRID_COLUMNS 20
+
+static void DeclareDashboard(int32_t rowCount, int32_t frame) {
+    CLAY(CLAY_ID("Outer"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } })) {
+        CLAY(CLAY_ID("Sidebar"), CLAY_RECTANGLE({ .color = { 30, 30, 30, 255 } }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(250), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .padding = { 8, 8 }, .childGap = 4 })) {
+            for (int32_t i = 0; i < 30; ++i) {
+                Clay_Color color = i == frame % 30 ? CLAY__INIT(Clay_Color) { 90, 90, 160, 255 } : CLAY__INIT(Clay_Color) { 50, 50, 50, 255 };
+                CLAY(CLAY_IDI("SidebarItem", i), CLAY_RECTANGLE({ .color = color }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0) }, .padding = { 6, 4 } })) {
+                    CLAY_TEXT(CLAY_STRING("Sidebar entry"), CLAY_TEXT_CONFIG({ .fontSize = 14 }));
+                }
+            }
+        }
+        CLAY(CLAY_ID("Grid"), CLAY_SCROLL({ .vertical = true }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 2 })) {
+            for (int32_t row = 0; row < rowCount; ++row) {
+                Clay_Color color = row == frame % rowCount ? CLAY__INIT(Clay_Color) { 200, 200, 255, 255 } : CLAY__INIT(Clay_Color) { 240, 240, 240, 255 };
+                CLAY(CLAY_IDI("Row", row), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0) }, .childGap = 2 })) {
+                    for (int32_t column = 0; column < GRID_COLUMNS; ++column) {
+                        CLAY(CLAY_IDI("Cell", row * GRID_COLUMNS + column), CLAY_RECTANGLE({ .color = color }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW((float)(column % 5) * 10) }, .padding = { 4, 2 } })) {
+                            CLAY_TEXT(CLAY_STRING("value 123.45 units"), CLAY_TEXT_CONFIG({ .fontSize = 12 }));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int32_t rowCount = Bench_SizeArgument(argc, argv, 1250);
+    int32_t frameCount = 50;
+    Bench_Initialize(rowCount * GRID_COLUMNS * 3 + 1000, CLAY__INIT(Clay_Dimensions) { 1600, 900 });
+    double fastestEndLayout = 1e9, fastestPasses = 1e9;
+    for (int32_t frame = 0; frame < frameCount; ++frame) {
+        // A different width every frame, so that nothing from the last frame's sizing can be reused
+        Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1600.0f + (float)(frame % 2) * 13, 900 });
+        Clay_BeginLayout();
+        DeclareDashboard(rowCount, frame);
+        double start = Bench_NowMilliseconds();
+        Clay_EndLayout();
+        double endLayoutEnd = Bench_NowMilliseconds();
+        // The tree is still there until the next Clay_BeginLayout, so the passes can be run over it again on their own
+        Clay__SizeContainersAlongAxis(true);
+        Clay__SizeContainersAlongAxis(false);
+        double passesEnd = Bench_NowMilliseconds();
+        // The first frames fill the caches
+        if (frame >= 2) {
+            fastestEndLayout = CLAY__MIN(fastestEndLayout, endLayoutEnd - start);
+            fastestPasses = CLAY__MIN(fastestPasses, passesEnd - endLayoutEnd);
+        }
+    }
+    printf("sizing_passes %5d rows (%6d elements): sizing passes %8.3f ms, Clay_EndLayout %8.3f ms\n", rowCount, Clay_GetCurrentContext()->layoutElements.length, fastestPasses, fastestEndLayout);
+    return 0;
+}
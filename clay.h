@@ -202,11 +202,19 @@ typedef struct {
     float x, y, width, height;
 } Clay_BoundingBox;
 
+// Element ids are 32 bit hashes unless CLAY_64BIT_IDS is defined. With tens of thousands of live elements two of them sharing
+// a 32 bit id becomes a real possibility, 64 bit ids make that vanishingly unlikely at the cost of a larger hash map.
+#ifdef CLAY_64BIT_IDS
+typedef uint64_t Clay_ElementIdValue;
+#else
+typedef uint32_t Clay_ElementIdValue;
+#endif
+
 // baseId + offset = id
 typedef struct {
-    uint32_t id;
-    uint32_t offset;
-    uint32_t baseId;
+    Clay_ElementIdValue id;
+    Clay_ElementIdValue offset;
+    Clay_ElementIdValue baseId;
     Clay_String stringId;
 } Clay_ElementId;
 
@@ -371,7 +379,7 @@ typedef struct {
     Clay_Vector2 offset;
     Clay_Dimensions expand;
     uint16_t zIndex;
-    uint32_t parentId;
+    Clay_ElementIdValue parentId;
     Clay_FloatingAttachPoints attachment;
     Clay_PointerCaptureMode pointerCaptureMode;
 } Clay_FloatingElementConfig;
@@ -467,7 +475,7 @@ typedef struct {
     Clay_ElementConfigUnion config;
     Clay_StringSlice text; // TODO I wish there was a way to avoid having to have this on every render command
     int32_t zIndex;
-    uint32_t id;
+    Clay_ElementIdValue id;
     Clay_RenderCommandType commandType;
 } Clay_RenderCommand;
 
@@ -489,6 +497,35 @@ typedef struct {
     Clay_PointerDataInteractionState state;
 } Clay_PointerData;
 
+typedef CLAY_PACKED_ENUM {
+    CLAY_POINTER_EVENT_ENTER,
+    CLAY_POINTER_EVENT_LEAVE,
+    CLAY_POINTER_EVENT_PRESS,
+    CLAY_POINTER_EVENT_RELEASE,
+} Clay_PointerEventType;
+
+typedef struct {
+    Clay_ElementId elementId;
+    Clay_Vector2 position; // Where the pointer was when the event happened
+    intptr_t userData; // As passed to Clay_OnPointerEvent
+    Clay_PointerEventType type;
+} Clay_PointerEvent;
+
+typedef struct {
+    int32_t capacity;
+    int32_t length;
+    Clay_PointerEvent* internalArray;
+} Clay_PointerEventArray;
+
+typedef struct {
+    Clay_Vector2 position;
+    bool pointerDown;
+    // Updated by Clay_SetPointerStates
+    Clay_PointerDataInteractionState state; // Advanced from its value in the previous call unless the ids didn't fit, keep the array around between calls
+    int32_t pointerOverIdsOffset; // The ids of the elements the pointer is over are pointerOverIds[offset, offset + length)
+    int32_t pointerOverIdsLength;
+} Clay_PointerBatchItem;
+
 typedef CLAY_PACKED_ENUM {
     CLAY_ERROR_TYPE_TEXT_MEASUREMENT_FUNCTION_NOT_PROVIDED,
     CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
@@ -510,15 +547,35 @@ typedef struct {
     uintptr_t userData;
 } Clay_ErrorHandler;
 
+typedef struct {
+    // Running totals since Clay_Initialize
+    uint64_t hits; // Text elements whose measurement was already cached
+    uint64_t misses; // Text elements that had to be split into words and measured
+    uint64_t evictions; // Cached measurements dropped after going unused for a few frames
+    uint64_t wordsMeasured; // Calls made to the measure text function
+    double measureTextFunctionSeconds; // Time spent measuring text, only tracked when Clay_SetQueryTimeFunction has been called. Parallel batches count their wall clock time.
+    uint32_t capacityExceededCount; // Measurements that failed because either the entry or word capacity was used up
+    // Current state of the cache
+    int32_t liveEntries;
+    int32_t entryCapacity;
+    int32_t entryFreeListLength;
+    int32_t liveWords;
+    int32_t wordsHighWaterMark; // Most words stored at once since the cache was last reset, compare against Clay_GetMaxMeasureTextCacheWordCount()
+    int32_t wordCapacity;
+    int32_t wordFreeListLength;
+} Clay_MeasureTextCacheStatistics;
+
 // Function Forward Declarations ---------------------------------
 // Public API functions ---
 uint32_t Clay_MinMemorySize(void);
 Clay_Arena Clay_CreateArenaWithCapacityAndMemory(uint32_t capacity, void *offset);
 void Clay_SetPointerState(Clay_Vector2 position, bool pointerDown);
+int32_t Clay_SetPointerStates(Clay_PointerBatchItem *pointers, int32_t pointerCount, Clay_ElementId *pointerOverIds, int32_t pointerOverIdsCapacity);
 Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler);
 Clay_Context* Clay_GetCurrentContext(void);
 void Clay_SetCurrentContext(Clay_Context* context);
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime);
+float Clay_GetNextScrollUpdateDelay(void);
 void Clay_SetLayoutDimensions(Clay_Dimensions dimensions);
 void Clay_BeginLayout(void);
 Clay_RenderCommandArray Clay_EndLayout(void);
@@ -527,11 +584,17 @@ Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString, uint32_t index);
 Clay_ElementData Clay_GetElementData (Clay_ElementId id);
 bool Clay_Hovered(void);
 void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerData, intptr_t userData), intptr_t userData);
+void Clay_OnPointerEvent(intptr_t userData);
+Clay_PointerEventArray Clay_GetPointerEvents(void);
 bool Clay_PointerOver(Clay_ElementId elementId);
 Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id);
 void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData), uintptr_t userData);
-void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, uintptr_t userData), uintptr_t userData);
+void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(Clay_ElementIdValue elementId, uintptr_t userData), uintptr_t userData);
+void Clay_SetQueryTimeFunction(double (*queryTimeFunction)(uintptr_t userData), uintptr_t userData);
+void Clay_SetMeasureTextParallelFunction(void (*parallelForFunction)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData), uintptr_t userData);
+void Clay_SetLayoutParallelFunction(void (*parallelForFunction)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData), uintptr_t userData);
 Clay_RenderCommand * Clay_RenderCommandArray_Get(Clay_RenderCommandArray* array, int32_t index);
+Clay_PointerEvent * Clay_PointerEventArray_Get(Clay_PointerEventArray* array, int32_t index);
 void Clay_SetDebugModeEnabled(bool enabled);
 bool Clay_IsDebugModeEnabled(void);
 void Clay_SetCullingEnabled(bool enabled);
@@ -540,6 +603,8 @@ void Clay_SetMaxElementCount(int32_t maxElementCount);
 int32_t Clay_GetMaxMeasureTextCacheWordCount(void);
 void Clay_SetMaxMeasureTextCacheWordCount(int32_t maxMeasureTextCacheWordCount);
 void Clay_ResetMeasureTextCache(void);
+Clay_MeasureTextCacheStatistics Clay_GetMeasureTextCacheStatistics(void);
+uint32_t Clay_GetElementIdCollisionCount(void);
 
 // Internal API functions required by macros
 void Clay__OpenElement(void);
@@ -556,9 +621,9 @@ Clay_FloatingElementConfig * Clay__StoreFloatingElementConfig(Clay_FloatingEleme
 Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConfig config);
 Clay_ScrollElementConfig * Clay__StoreScrollElementConfig(Clay_ScrollElementConfig config);
 Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config);
-Clay_ElementId Clay__HashString(Clay_String key, uint32_t offset, uint32_t seed);
+Clay_ElementId Clay__HashString(Clay_String key, Clay_ElementIdValue offset, Clay_ElementIdValue seed);
 void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig);
-uint32_t Clay__GetParentElementId(void);
+Clay_ElementIdValue Clay__GetParentElementId(void);
 
 extern Clay_Color Clay__debugViewHighlightColor;
 extern uint32_t Clay__debugViewWidth;
@@ -583,6 +648,20 @@ extern uint32_t Clay__debugViewWidth;
 #define CLAY__MAXFLOAT 3.40282346638528859812e+38F
 #endif
 
+// The word boundary scan used by the text measurement cache is vectorised when the compiler targets SSE2 or AVX2.
+// Define CLAY_DISABLE_SIMD to always use the portable version.
+#if !defined(CLAY_DISABLE_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define CLAY__SIMD_AVX2
+#define CLAY__SIMD_SSE2
+#elif !defined(CLAY_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CLAY__SIMD_SSE2
+#endif
+#if defined(CLAY__SIMD_SSE2) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 Clay_LayoutConfig CLAY_LAYOUT_DEFAULT = CLAY__DEFAULT_STRUCT;
 
 #define CLAY__ARRAY_DEFINE_FUNCTIONS(typeName, arrayName) \
@@ -685,8 +764,12 @@ bool Clay__Array_AddCapacityCheck(int32_t length, int32_t capacity);
 
 CLAY__ARRAY_DEFINE(bool, Clay__boolArray)
 CLAY__ARRAY_DEFINE(int32_t, Clay__int32_tArray)
+CLAY__ARRAY_DEFINE(uint8_t, Clay__uint8_tArray)
+CLAY__ARRAY_DEFINE(float, Clay__floatArray)
 CLAY__ARRAY_DEFINE(char, Clay__charArray)
+CLAY__ARRAY_DEFINE(Clay_ElementIdValue, Clay__ElementIdValueArray)
 CLAY__ARRAY_DEFINE(Clay_ElementId, Clay__ElementIdArray)
+CLAY__ARRAY_DEFINE(Clay_BoundingBox, Clay__BoundingBoxArray)
 CLAY__ARRAY_DEFINE(Clay_ElementConfig, Clay__ElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_LayoutConfig, Clay__LayoutConfigArray)
 CLAY__ARRAY_DEFINE(Clay_RectangleElementConfig, Clay__RectangleElementConfigArray)
@@ -698,10 +781,41 @@ CLAY__ARRAY_DEFINE(Clay_ScrollElementConfig, Clay__ScrollElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_BorderElementConfig, Clay__BorderElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_String, Clay__StringArray)
 CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_RenderCommand, Clay_RenderCommandArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_PointerEvent, Clay_PointerEventArray)
+
+typedef struct {
+    int32_t startOffset;
+    int32_t length;
+    float width;
+    int32_t next;
+} Clay__MeasuredWord;
+
+CLAY__ARRAY_DEFINE(Clay__MeasuredWord, Clay__MeasuredWordArray)
+
+typedef struct {
+    Clay_Dimensions unwrappedDimensions;
+    int32_t measuredWordsStartIndex;
+    bool containsNewlines;
+    bool measurementPending; // Words have been split out but not measured yet, see Clay__MeasurePendingText
+    // Result of the most recent wrap, stored in wrappedTextLinesCache and only valid while wrappedLinesEpoch matches the context
+    float wrappedContainerWidth;
+    float wrappedLineHeight;
+    int32_t wrappedLinesStartIndex;
+    int32_t wrappedLinesLength;
+    uint32_t wrappedLinesEpoch;
+    // Hash map data
+    uint32_t id;
+    int32_t nextIndex;
+    uint32_t generation;
+} Clay__MeasureTextCacheItem;
+
+CLAY__ARRAY_DEFINE(Clay__MeasureTextCacheItem, Clay__MeasureTextCacheItemArray)
 
 typedef struct {
     Clay_Dimensions dimensions;
-    Clay_String line;
+    int32_t startOffset; // Relative to the start of the text, so that cached lines stay valid if the text is moved in memory
+    int32_t length;
+    float yOffset; // Top of the line relative to the top of the text element, increases from line to line
 } Clay__WrappedTextLine;
 
 CLAY__ARRAY_DEFINE(Clay__WrappedTextLine, Clay__WrappedTextLineArray)
@@ -711,6 +825,7 @@ typedef struct {
     Clay_Dimensions preferredDimensions;
     int32_t elementIndex;
     Clay__WrappedTextLineArraySlice wrappedLines;
+    Clay__MeasureTextCacheItem *measured; // Looked up once when the element is declared, entries used this frame aren't evicted
 } Clay__TextElementData;
 
 CLAY__ARRAY_DEFINE(Clay__TextElementData, Clay__TextElementDataArray)
@@ -730,7 +845,7 @@ typedef struct {
     Clay_LayoutConfig *layoutConfig;
     Clay__ElementConfigArraySlice elementConfigs;
     uint32_t configsEnabled;
-    uint32_t id;
+    Clay_ElementIdValue id;
 } Clay_LayoutElement;
 
 CLAY__ARRAY_DEFINE(Clay_LayoutElement, Clay_LayoutElementArray)
@@ -741,11 +856,11 @@ typedef struct {
     Clay_Dimensions contentSize;
     Clay_Vector2 scrollOrigin;
     Clay_Vector2 pointerOrigin;
-    Clay_Vector2 scrollMomentum;
+    Clay_Vector2 scrollMomentum; // Pixels per second, see Clay__ApplyScrollMomentum
     Clay_Vector2 scrollPosition;
     Clay_Vector2 previousDelta;
     float momentumTime;
-    uint32_t elementId;
+    Clay_ElementIdValue elementId;
     bool openThisFrame;
     bool pointerScrollActive;
 } Clay__ScrollContainerDataInternal;
@@ -765,33 +880,85 @@ typedef struct { // todo get this struct into a single cache line
     Clay_LayoutElement* layoutElement;
     void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData);
     intptr_t hoverFunctionUserData;
-    int32_t nextIndex;
     uint32_t generation;
     Clay__DebugElementData *debugData;
+    uint64_t layoutFingerprint; // Fingerprint of the element's subtree the last time it was laid out, zero if it couldn't be reused
+    Clay_Dimensions layoutDimensions; // Final dimensions from the last time the element was laid out
+    uint32_t layoutGeneration; // Context generation of that layout
+    uint32_t boundingBoxGeneration; // Context generation the bounding box was calculated in, lags behind while the element is in a culled subtree
+    uint32_t pointerOverGeneration; // Matches the context's when the last Clay_SetPointerState found the pointer over the element
+    uint32_t pointerEventGeneration; // Equal to generation if the element called Clay_OnPointerEvent the last time it was declared
+    uint32_t pointerEventTargetGeneration; // Matches the context's pointerOverGeneration while the element is in pointerEventTargets
+    intptr_t pointerEventUserData;
+    int32_t scrollContainerDataIndex; // Where the element's scroll data is in scrollContainerDatas, see Clay__GetItemScrollContainerData
 } Clay_LayoutElementHashMapItem;
 
 CLAY__ARRAY_DEFINE(Clay_LayoutElementHashMapItem, Clay__LayoutElementHashMapItemArray)
 
+// The element hash map is open addressed, and only keeps the ids in its slots so that probing doesn't touch the much larger items
 typedef struct {
-    int32_t startOffset;
+    Clay_ElementIdValue id; // Zero if the slot is empty, element ids are never zero
+    int32_t itemIndex; // Index into layoutElementsHashMapInternal
+} Clay__LayoutElementHashMapSlot;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutElementHashMapSlot, Clay__LayoutElementHashMapSlotArray)
+
+// Matches a layout element up with its persistent hash map item, and fingerprints everything that can affect the sizes inside its subtree.
+// A subtree whose fingerprint and own size are the same as in the previous frame reuses the sizes its descendants had then.
+typedef struct {
+    uint64_t fingerprint;
+    Clay_LayoutElementHashMapItem *hashMapItem;
+    bool reusable; // False if this element or one of its descendants can't be matched up with the previous frame
+} Clay__LayoutElementFingerprint;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutElementFingerprint, Clay__LayoutElementFingerprintArray)
+
+// The parts of an element's configs that the sizing passes branch on, packed into a byte per element when it closes.
+// Reading them here keeps the passes from following each child's config slice to find its text or scroll config.
+typedef CLAY_PACKED_ENUM {
+    CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_X = 1, // Can be compressed or grown, i.e. not PERCENT or FIXED and not text that doesn't wrap
+    CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_Y = 2,
+    CLAY__LAYOUT_SIZING_FLAG_SCROLL_X = 4,
+    CLAY__LAYOUT_SIZING_FLAG_SCROLL_Y = 8,
+} Clay__LayoutSizingFlag;
+
+// A run of subtrees that are sized together on one thread, using their own slice of the sizing buffers
+typedef struct {
+    int32_t subtreeRootsStart;
+    int32_t subtreeRootsEnd;
+    int32_t scratchOffset;
+    int32_t scratchLength; // Total element count of the subtrees, which bounds every buffer they need
+} Clay__LayoutSizingTask;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutSizingTask, Clay__LayoutSizingTaskArray)
+
+// A cache item whose words are waiting to be measured
+typedef struct {
+    Clay__MeasureTextCacheItem *measured;
+    const char *chars;
+    int32_t textLength;
+    Clay_TextElementConfig *config;
+} Clay__PendingTextMeasurement;
+
+CLAY__ARRAY_DEFINE(Clay__PendingTextMeasurement, Clay__PendingTextMeasurementArray)
+
+// A single call to the measure text function. Requests for the same pending measurement are stored contiguously and in text order.
+typedef struct {
+    int32_t pendingIndex;
+    int32_t startOffset; // -1 measures a single space character
     int32_t length;
-    float width;
-    int32_t next;
-} Clay__MeasuredWord;
+    Clay_Dimensions dimensions;
+} Clay__TextMeasurementRequest;
 
-CLAY__ARRAY_DEFINE(Clay__MeasuredWord, Clay__MeasuredWordArray)
+CLAY__ARRAY_DEFINE(Clay__TextMeasurementRequest, Clay__TextMeasurementRequestArray)
 
+// A text element that was opened while its measurement was pending, and needs its dimensions filled in afterwards
 typedef struct {
-    Clay_Dimensions unwrappedDimensions;
-    int32_t measuredWordsStartIndex;
-    bool containsNewlines;
-    // Hash map data
-    uint32_t id;
-    int32_t nextIndex;
-    uint32_t generation;
-} Clay__MeasureTextCacheItem;
+    Clay__MeasureTextCacheItem *measured;
+    int32_t textElementDataIndex;
+} Clay__DeferredTextElement;
 
-CLAY__ARRAY_DEFINE(Clay__MeasureTextCacheItem, Clay__MeasureTextCacheItemArray)
+CLAY__ARRAY_DEFINE(Clay__DeferredTextElement, Clay__DeferredTextElementArray)
 
 typedef struct {
     Clay_LayoutElement *layoutElement;
@@ -801,10 +968,32 @@ typedef struct {
 
 CLAY__ARRAY_DEFINE(Clay__LayoutElementTreeNode, Clay__LayoutElementTreeNodeArray)
 
+// Kept as edges rather than a bounding box so that growing one to take in another doesn't round its far edges inwards
+typedef struct {
+    float left, top, right, bottom;
+} Clay__SubtreeBounds;
+
+CLAY__ARRAY_DEFINE(Clay__SubtreeBounds, Clay__SubtreeBoundsArray)
+
+// Each bit of pointerMask is one of the up to 64 pointers a pass of Clay_SetPointerStates hit tests together
+typedef struct {
+    int32_t layoutElementIndex;
+    uint64_t pointerMask;
+} Clay__PointerBatchTask;
+
+CLAY__ARRAY_DEFINE(Clay__PointerBatchTask, Clay__PointerBatchTaskArray)
+
+typedef struct {
+    int32_t pointerIndex;
+    uint32_t sortKey;
+} Clay__PointerBatchOrder;
+
+CLAY__ARRAY_DEFINE(Clay__PointerBatchOrder, Clay__PointerBatchOrderArray)
+
 typedef struct {
     int32_t layoutElementIndex;
-    uint32_t parentId; // This can be zero in the case of the root layout tree
-    uint32_t clipElementId; // This can be zero if there is no clip element
+    Clay_ElementIdValue parentId; // This can be zero in the case of the root layout tree
+    Clay_ElementIdValue clipElementId; // This can be zero if there is no clip element
     int32_t zIndex;
     Clay_Vector2 pointerOffset; // Only used when scroll containers are managed externally
 } Clay__LayoutElementTreeRoot;
@@ -826,11 +1015,25 @@ struct Clay_Context {
     bool debugModeEnabled;
     bool disableCulling;
     bool externalScrollHandlingEnabled;
-    uint32_t debugSelectedElementId;
+    Clay_ElementIdValue debugSelectedElementId;
     uint32_t generation;
+    uint32_t elementIdCollisionCount; // Times two different element ids have hashed to the same value, see Clay_GetElementIdCollisionCount
+    uint32_t pointerOverGeneration; // Counts calls to Clay_SetPointerState, so that stamps left by earlier ones don't match
+    uint64_t pointerOverIdBits; // One bit per id in pointerOverIds, picked by its low six bits
+    uint32_t wrappedTextLinesCacheEpoch;
+    uint32_t layoutFingerprintEpoch; // Mixed into every fingerprint, changing it makes every element re-run layout
+    int32_t layoutElementsHashMapSweepIndex; // Where Clay__SweepLayoutElementHashMap picks up from
+    uint32_t layoutElementsHashMapFullSweepGeneration;
+    bool wrappedTextLinesCacheFull;
+    bool measureTextDeferred;
+    bool textElementsDeferred;
     uintptr_t arenaResetOffset;
     uintptr_t mesureTextUserData;
     uintptr_t queryScrollOffsetUserData;
+    uintptr_t queryTimeUserData;
+    uintptr_t measureTextParallelUserData;
+    uintptr_t layoutParallelUserData;
+    Clay_MeasureTextCacheStatistics measureTextCacheStatistics;
     Clay_Arena internalArena;
     // Layout Elements / Render Commands
     Clay_LayoutElementArray layoutElements;
@@ -841,7 +1044,16 @@ struct Clay_Context {
     Clay__TextElementDataArray textElementData;
     Clay__int32_tArray imageElementPointers;
     Clay__int32_tArray reusableElementIndexBuffer;
-    Clay__int32_tArray layoutElementClipElementIds;
+    Clay__floatArray sizingScratchBuffer;
+    Clay__ElementIdValueArray layoutElementClipElementIds;
+    Clay__LayoutElementFingerprintArray layoutElementFingerprints;
+    Clay__int32_tArray layoutElementSubtreeSizes;
+    Clay__uint8_tArray layoutElementSizingFlags;
+    Clay__boolArray layoutElementSubtreeContained;
+    Clay__SubtreeBoundsArray layoutElementSubtreeBounds;
+    Clay__boolArray layoutElementChildrenOrdered;
+    Clay__int32_tArray layoutSizingSubtreeRoots;
+    Clay__LayoutSizingTaskArray layoutSizingTasks;
     // Configs
     Clay__LayoutConfigArray layoutConfigs;
     Clay__ElementConfigArray elementConfigBuffer;
@@ -856,17 +1068,34 @@ struct Clay_Context {
     // Misc Data Structures
     Clay__StringArray layoutElementIdStrings;
     Clay__WrappedTextLineArray wrappedTextLines;
+    Clay__WrappedTextLineArray wrappedTextLinesCache;
     Clay__LayoutElementTreeNodeArray layoutElementTreeNodeArray1;
     Clay__LayoutElementTreeRootArray layoutElementTreeRoots;
+    Clay__LayoutElementTreeRootArray layoutElementTreeRootsSortBuffer;
+    Clay__LayoutElementTreeNodeArray culledLayoutElements;
+    Clay__int32_tArray culledLayoutElementIndices; // Scratch space for Clay__PositionCulledLayoutElements
+    Clay__PointerBatchTaskArray pointerBatchTasks; // Scratch space for Clay_SetPointerStates
+    Clay__PointerBatchTaskArray pointerBatchHits;
+    Clay__PointerBatchOrderArray pointerBatchOrder;
+    Clay__PointerBatchOrderArray pointerBatchOrderBuffer;
+    Clay__BoundingBoxArray visibleRectStack;
     Clay__LayoutElementHashMapItemArray layoutElementsHashMapInternal;
-    Clay__int32_tArray layoutElementsHashMap;
+    Clay__LayoutElementHashMapSlotArray layoutElementsHashMap; // Capacity is a power of two, see Clay__LayoutElementHashMapBucket
+    Clay__int32_tArray layoutElementsHashMapInternalFreeList;
     Clay__MeasureTextCacheItemArray measureTextHashMapInternal;
     Clay__int32_tArray measureTextHashMapInternalFreeList;
     Clay__int32_tArray measureTextHashMap;
     Clay__MeasuredWordArray measuredWords;
     Clay__int32_tArray measuredWordsFreeList;
-    Clay__int32_tArray openClipElementStack;
+    Clay__int32_tArray measureTextWordBoundaries;
+    Clay__PendingTextMeasurementArray pendingTextMeasurements;
+    Clay__TextMeasurementRequestArray textMeasurementRequests;
+    Clay__DeferredTextElementArray deferredTextElements;
+    Clay__ElementIdValueArray openClipElementStack;
     Clay__ElementIdArray pointerOverIds;
+    Clay_PointerEventArray pointerEvents; // Queued by Clay_SetPointerState, cleared by Clay_EndLayout
+    Clay_PointerEventArray pointerEventTargets; // The elements taking pointer events that the pointer is over, type is ENTER for ones it wasn't over before
+    Clay_PointerEventArray pointerEventTargetsBuffer; // Swapped with pointerEventTargets, holds the ones from the call before
     Clay__ScrollContainerDataInternalArray scrollContainerDatas;
     Clay__boolArray treeNodeVisited;
     Clay__charArray dynamicStringData;
@@ -894,12 +1123,27 @@ Clay_String Clay__WriteStringToCharBuffer(Clay__charArray *buffer, Clay_String s
     return CLAY__INIT(Clay_String) { .length = string.length, .chars = (const char *)(buffer->internalArray + buffer->length - string.length) };
 }
 
+bool Clay__StringEquals(Clay_String a, Clay_String b) {
+    if (a.length != b.length) {
+        return false;
+    }
+    for (int32_t i = 0; i < a.length; i++) {
+        if (a.chars[i] != b.chars[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #ifdef CLAY_WASM
     __attribute__((import_module("clay"), import_name("measureTextFunction"))) Clay_Dimensions Clay__MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData);
-    __attribute__((import_module("clay"), import_name("queryScrollOffsetFunction"))) Clay_Vector2 Clay__QueryScrollOffset(uint32_t elementId, uintptr_t userData);
+    __attribute__((import_module("clay"), import_name("queryScrollOffsetFunction"))) Clay_Vector2 Clay__QueryScrollOffset(Clay_ElementIdValue elementId, uintptr_t userData);
 #else
     Clay_Dimensions (*Clay__MeasureText)(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData);
-    Clay_Vector2 (*Clay__QueryScrollOffset)(uint32_t elementId, uintptr_t userData);
+    Clay_Vector2 (*Clay__QueryScrollOffset)(Clay_ElementIdValue elementId, uintptr_t userData);
+    double (*Clay__QueryTime)(uintptr_t userData);
+    void (*Clay__MeasureTextParallel)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData);
+    void (*Clay__LayoutParallel)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData);
 #endif
 
 Clay_LayoutElement* Clay__GetOpenLayoutElement(void) {
@@ -907,7 +1151,7 @@ Clay_LayoutElement* Clay__GetOpenLayoutElement(void) {
     return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1));
 }
 
-uint32_t Clay__GetParentElementId(void) {
+Clay_ElementIdValue Clay__GetParentElementId(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2))->id;
 }
@@ -917,6 +1161,9 @@ bool Clay__ElementHasConfig(Clay_LayoutElement *element, Clay__ElementConfigType
 }
 
 Clay_ElementConfigUnion Clay__FindElementConfigWithType(Clay_LayoutElement *element, Clay__ElementConfigType type) {
+    if (!Clay__ElementHasConfig(element, type)) {
+        return CLAY__INIT(Clay_ElementConfigUnion) { NULL };
+    }
     for (int32_t i = 0; i < element->elementConfigs.length; i++) {
         Clay_ElementConfig *config = Clay__ElementConfigArraySlice_Get(&element->elementConfigs, i);
         if (config->type == type) {
@@ -926,7 +1173,84 @@ Clay_ElementConfigUnion Clay__FindElementConfigWithType(Clay_LayoutElement *elem
     return CLAY__INIT(Clay_ElementConfigUnion) { NULL };
 }
 
-Clay_ElementId Clay__HashNumber(const uint32_t offset, const uint32_t seed) {
+#ifdef CLAY_64BIT_IDS
+// The 64 bit finalizer from MurmurHash3. It can be undone, so different inputs always give different outputs.
+uint64_t Clay__MixId(uint64_t id) {
+    id ^= id >> 33;
+    id *= 0xff51afd7ed558ccdULL;
+    id ^= id >> 33;
+    id *= 0xc4ceb9fe1a85ec53ULL;
+    id ^= id >> 33;
+    return id;
+}
+
+// Eight bytes of the string as a little endian word, which compilers turn into a single unaligned load
+uint64_t Clay__ReadIdWord(const char *chars) {
+    const uint8_t *bytes = (const uint8_t *)chars;
+    return (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8) | ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24)
+        | ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) | ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+}
+
+uint32_t Clay__ReadIdHalfWord(const char *chars) {
+    const uint8_t *bytes = (const uint8_t *)chars;
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+// The last one to seven bytes of the string as a word. Longer strings take the final eight bytes and shift off the ones that
+// were already hashed, shorter ones read overlapping halves or pick out single bytes, the way wyhash does. Every byte ends up
+// in the word, and the string's length is hashed as well, so no two strings give the same words.
+uint64_t Clay__ReadIdTail(Clay_String key, int32_t offset) {
+    int32_t remaining = key.length - offset;
+    if (key.length >= 8) {
+        return Clay__ReadIdWord(key.chars + key.length - 8) >> ((8 - remaining) * 8);
+    }
+    if (remaining >= 4) {
+        return (uint64_t)Clay__ReadIdHalfWord(key.chars + offset) | ((uint64_t)Clay__ReadIdHalfWord(key.chars + key.length - 4) << 32);
+    }
+    const uint8_t *bytes = (const uint8_t *)key.chars + offset;
+    return (uint64_t)bytes[0] | ((uint64_t)bytes[remaining / 2] << 8) | ((uint64_t)bytes[remaining - 1] << 16);
+}
+
+// One step of MurmurHash64A, taking a whole word of the string at a time rather than one character
+uint64_t Clay__HashIdWord(uint64_t hash, uint64_t word) {
+    word *= 0xc6a4a7935bd1e995ULL;
+    word ^= word >> 47;
+    word *= 0xc6a4a7935bd1e995ULL;
+    hash ^= word;
+    return hash * 0xc6a4a7935bd1e995ULL;
+}
+
+// Multiplying by an odd number and mixing can both be undone, so no two offsets from the same base share an id
+uint64_t Clay__HashIdOffset(uint64_t base, uint64_t offset) {
+    return Clay__MixId(base ^ ((offset + 1) * 0x9e3779b97f4a7c15ULL)) + 1; // Reserve the hash result of zero as "null id"
+}
+
+Clay_ElementId Clay__HashNumber(const Clay_ElementIdValue offset, const Clay_ElementIdValue seed) {
+    return CLAY__INIT(Clay_ElementId) { .id = Clay__HashIdOffset(seed, offset), .offset = offset, .baseId = seed, .stringId = CLAY__STRING_DEFAULT };
+}
+
+Clay_ElementId Clay__HashString(Clay_String key, const Clay_ElementIdValue offset, const Clay_ElementIdValue seed) {
+    uint64_t base = seed ^ ((uint64_t)key.length * 0xc6a4a7935bd1e995ULL);
+    int32_t i = 0;
+    for (; i + 8 <= key.length; i += 8) {
+        base = Clay__HashIdWord(base, Clay__ReadIdWord(key.chars + i));
+    }
+    if (i < key.length) {
+        base = Clay__HashIdWord(base, Clay__ReadIdTail(key, i));
+    }
+    return CLAY__INIT(Clay_ElementId) { .id = Clay__HashIdOffset(base, offset), .offset = offset, .baseId = base, .stringId = key };
+}
+
+// Gives the same id as hashing the element's string again with number as the offset
+Clay_ElementId Clay__Rehash(Clay_ElementId elementId, uint32_t number) {
+    return CLAY__INIT(Clay_ElementId) { .id = Clay__HashIdOffset(elementId.baseId, number), .offset = number, .baseId = elementId.baseId, .stringId = elementId.stringId };
+}
+
+Clay_ElementIdValue Clay__RehashWithNumber(Clay_ElementIdValue id, uint32_t number) {
+    return Clay__MixId(id + number);
+}
+#else
+Clay_ElementId Clay__HashNumber(const Clay_ElementIdValue offset, const Clay_ElementIdValue seed) {
     uint32_t hash = seed;
     hash += (offset + 48);
     hash += (hash << 10);
@@ -938,7 +1262,7 @@ Clay_ElementId Clay__HashNumber(const uint32_t offset, const uint32_t seed) {
     return CLAY__INIT(Clay_ElementId) { .id = hash + 1, .offset = offset, .baseId = seed, .stringId = CLAY__STRING_DEFAULT }; // Reserve the hash result of zero as "null id"
 }
 
-Clay_ElementId Clay__HashString(Clay_String key, const uint32_t offset, const uint32_t seed) {
+Clay_ElementId Clay__HashString(Clay_String key, const Clay_ElementIdValue offset, const Clay_ElementIdValue seed) {
     uint32_t hash = 0;
     uint32_t base = seed;
 
@@ -973,7 +1297,7 @@ Clay_ElementId Clay__Rehash(Clay_ElementId elementId, uint32_t number) {
     return CLAY__INIT(Clay_ElementId) { .id = id, .offset = number, .baseId = elementId.baseId, .stringId = elementId.stringId };
 }
 
-uint32_t Clay__RehashWithNumber(uint32_t id, uint32_t number) {
+Clay_ElementIdValue Clay__RehashWithNumber(Clay_ElementIdValue id, uint32_t number) {
     id += number;
     id += (id << 10);
     id ^= (id >> 6);
@@ -983,6 +1307,7 @@ uint32_t Clay__RehashWithNumber(uint32_t id, uint32_t number) {
     id += (id << 15);
     return id;
 }
+#endif
 
 uint32_t Clay__HashTextWithConfig(Clay_String *text, Clay_TextElementConfig *config) {
     uint32_t hash = 0;
@@ -1045,6 +1370,194 @@ Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__Measure
     }
 }
 
+#ifdef CLAY__SIMD_SSE2
+int32_t Clay__CountTrailingZeros(uint32_t value) {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (int32_t)index;
+    #else
+    return __builtin_ctz(value);
+    #endif
+}
+#endif
+
+// Writes the offsets of every ' ' and '\n' in chars[start, end) into boundaries, overwriting its contents.
+// Returns the offset the scan stopped at, which is only less than end if the boundaries buffer filled up.
+int32_t Clay__ScanWordBoundaries(const char *chars, int32_t start, int32_t end, Clay__int32_tArray *boundaries) {
+    int32_t position = start;
+    int32_t *output = boundaries->internalArray;
+    int32_t capacity = boundaries->capacity;
+    boundaries->length = 0;
+    #ifdef CLAY__SIMD_AVX2
+    const __m256i spaces32 = _mm256_set1_epi8(' ');
+    const __m256i newlines32 = _mm256_set1_epi8('\n');
+    while (position + 32 <= end) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(chars + position));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaces32), _mm256_cmpeq_epi8(chunk, newlines32)));
+        while (mask != 0) {
+            if (boundaries->length == capacity) {
+                return output[capacity - 1] + 1;
+            }
+            output[boundaries->length++] = position + Clay__CountTrailingZeros(mask);
+            mask &= mask - 1;
+        }
+        position += 32;
+    }
+    #endif
+    #ifdef CLAY__SIMD_SSE2
+    const __m128i spaces16 = _mm_set1_epi8(' ');
+    const __m128i newlines16 = _mm_set1_epi8('\n');
+    while (position + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(chars + position));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, spaces16), _mm_cmpeq_epi8(chunk, newlines16)));
+        while (mask != 0) {
+            if (boundaries->length == capacity) {
+                return output[capacity - 1] + 1;
+            }
+            output[boundaries->length++] = position + Clay__CountTrailingZeros(mask);
+            mask &= mask - 1;
+        }
+        position += 16;
+    }
+    #endif
+    // Scalar tail, and the whole scan on targets without SSE2
+    for (; position < end; ++position) {
+        if (chars[position] == ' ' || chars[position] == '\n') {
+            if (boundaries->length == capacity) {
+                return output[capacity - 1] + 1;
+            }
+            output[boundaries->length++] = position;
+        }
+    }
+    return end;
+}
+
+bool Clay__MeasuredWordsCapacityExceeded(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->measuredWords.length < context->measuredWords.capacity - 1) {
+        return false;
+    }
+    context->measureTextCacheStatistics.capacityExceededCount++;
+    if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
+            .userData = context->errorHandler.userData });
+        context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+    }
+    return true;
+}
+
+#define CLAY__TEXT_MEASUREMENT_BATCH_SIZE 64
+
+void Clay__MeasureTextRequest(Clay_Context *context, Clay__TextMeasurementRequest *request) {
+    Clay__PendingTextMeasurement *pending = &context->pendingTextMeasurements.internalArray[request->pendingIndex];
+    Clay_StringSlice slice = request->startOffset < 0
+        ? CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }
+        : CLAY__INIT(Clay_StringSlice) { .length = request->length, .chars = &pending->chars[request->startOffset], .baseChars = pending->chars };
+    request->dimensions = Clay__MeasureText(slice, pending->config, context->mesureTextUserData);
+}
+
+// Runs on worker threads, so it must only touch the requests in its own batch
+void Clay__MeasureTextRequestBatch(int32_t taskIndex, void *taskData) {
+    Clay_Context *context = (Clay_Context *)taskData;
+    int32_t start = taskIndex * CLAY__TEXT_MEASUREMENT_BATCH_SIZE;
+    int32_t end = CLAY__MIN(start + CLAY__TEXT_MEASUREMENT_BATCH_SIZE, context->textMeasurementRequests.length);
+    for (int32_t i = start; i < end; ++i) {
+        Clay__MeasureTextRequest(context, &context->textMeasurementRequests.internalArray[i]);
+    }
+}
+
+void Clay__ApplyTextMeasurement(Clay_LayoutElement *textElement, Clay__TextElementData *textElementData, Clay__MeasureTextCacheItem *measured, Clay_TextElementConfig *textConfig) {
+    Clay_Dimensions textDimensions = { .width = measured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : measured->unwrappedDimensions.height };
+    textElement->dimensions = textDimensions;
+    textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = measured->unwrappedDimensions.height, .height = textDimensions.height }; // TODO not sure this is the best way to decide min width for text
+    textElementData->preferredDimensions = measured->unwrappedDimensions;
+}
+
+// Calls the measure text function for every outstanding request, then fills in the widths of the measured words and the
+// dimensions of their cache items. Text elements that were opened before their measurement finished are updated too.
+void Clay__MeasurePendingText(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__TextMeasurementRequestArray *requests = &context->textMeasurementRequests;
+    if (requests->length > 0) {
+        context->measureTextCacheStatistics.wordsMeasured += (uint64_t)requests->length;
+        #ifndef CLAY_WASM
+        double startTime = Clay__QueryTime ? Clay__QueryTime(context->queryTimeUserData) : 0;
+        if (Clay__MeasureTextParallel && context->measureTextDeferred) {
+            int32_t taskCount = (requests->length + CLAY__TEXT_MEASUREMENT_BATCH_SIZE - 1) / CLAY__TEXT_MEASUREMENT_BATCH_SIZE;
+            Clay__MeasureTextParallel(Clay__MeasureTextRequestBatch, context, taskCount, context->measureTextParallelUserData);
+        } else
+        #endif
+        {
+            for (int32_t i = 0; i < requests->length; ++i) {
+                Clay__MeasureTextRequest(context, &requests->internalArray[i]);
+            }
+        }
+        #ifndef CLAY_WASM
+        if (Clay__QueryTime) {
+            context->measureTextCacheStatistics.measureTextFunctionSeconds += Clay__QueryTime(context->queryTimeUserData) - startTime;
+        }
+        #endif
+    }
+
+    int32_t requestIndex = 0;
+    for (int32_t pendingIndex = 0; pendingIndex < context->pendingTextMeasurements.length; ++pendingIndex) {
+        Clay__PendingTextMeasurement *pending = &context->pendingTextMeasurements.internalArray[pendingIndex];
+        Clay__MeasureTextCacheItem *measured = pending->measured;
+        // The first request of every pending measurement is the width of a space
+        float spaceWidth = requests->internalArray[requestIndex++].dimensions.width;
+        float lineWidth = 0;
+        float measuredWidth = 0;
+        float measuredHeight = 0;
+        int32_t wordIndex = measured->measuredWordsStartIndex;
+        for (; requestIndex < requests->length && requests->internalArray[requestIndex].pendingIndex == pendingIndex; ++requestIndex) {
+            Clay__TextMeasurementRequest *request = &requests->internalArray[requestIndex];
+            Clay_Dimensions dimensions = request->dimensions;
+            int32_t end = request->startOffset + request->length;
+            measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
+            if (end == pending->textLength) {
+                // Final word, not followed by a delimiter
+                Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex)->width = dimensions.width;
+                lineWidth += dimensions.width;
+            } else if (pending->chars[end] == ' ') {
+                dimensions.width += spaceWidth;
+                Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
+                measuredWord->width = dimensions.width;
+                wordIndex = measuredWord->next;
+                lineWidth += dimensions.width;
+            } else {
+                if (request->length > 0) {
+                    Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
+                    measuredWord->width = dimensions.width;
+                    wordIndex = measuredWord->next;
+                }
+                // Skip the zero length word that marks the newline
+                wordIndex = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex)->next;
+                lineWidth += dimensions.width;
+                measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
+                lineWidth = 0;
+            }
+        }
+        measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
+        measured->unwrappedDimensions.width = measuredWidth;
+        measured->unwrappedDimensions.height = measuredHeight;
+        measured->measurementPending = false;
+    }
+
+    for (int32_t i = 0; i < context->deferredTextElements.length; ++i) {
+        Clay__DeferredTextElement *deferredTextElement = &context->deferredTextElements.internalArray[i];
+        Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&context->textElementData, deferredTextElement->textElementDataIndex);
+        Clay_LayoutElement *textElement = Clay_LayoutElementArray_Get(&context->layoutElements, textElementData->elementIndex);
+        Clay__ApplyTextMeasurement(textElement, textElementData, deferredTextElement->measured, Clay__FindElementConfigWithType(textElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig);
+    }
+
+    context->pendingTextMeasurements.length = 0;
+    requests->length = 0;
+    context->deferredTextElements.length = 0;
+}
+
 Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_TextElementConfig *config) {
     Clay_Context* context = Clay_GetCurrentContext();
     #ifndef CLAY_WASM
@@ -1067,6 +1580,7 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
         if (hashEntry->id == id) {
             hashEntry->generation = context->generation;
+            context->measureTextCacheStatistics.hits++;
             return hashEntry;
         }
         // This element hasn't been seen in a few frames, delete the hash map item
@@ -1082,6 +1596,7 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
             int32_t nextIndex = hashEntry->nextIndex;
             Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, elementIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
             Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, elementIndex);
+            context->measureTextCacheStatistics.evictions++;
             if (elementIndexPrevious == 0) {
                 context->measureTextHashMap.internalArray[hashBucket] = nextIndex;
             } else {
@@ -1095,6 +1610,7 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         }
     }
 
+    context->measureTextCacheStatistics.misses++;
     int32_t newItemIndex = 0;
     Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = context->generation };
     Clay__MeasureTextCacheItem *measured = NULL;
@@ -1105,6 +1621,7 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, newItemIndex);
     } else {
         if (context->measureTextHashMapInternal.length == context->measureTextHashMapInternal.capacity - 1) {
+            context->measureTextCacheStatistics.capacityExceededCount++;
             if (context->booleanWarnings.maxTextMeasureCacheExceeded) {
                 context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                         .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
@@ -1118,66 +1635,66 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         newItemIndex = context->measureTextHashMapInternal.length - 1;
     }
 
+    if (context->measureTextDeferred) {
+        // Measure everything collected so far if this text might not fit in the space that is left
+        if (context->pendingTextMeasurements.length == context->pendingTextMeasurements.capacity || context->textMeasurementRequests.length + text->length + 2 > context->textMeasurementRequests.capacity) {
+            Clay__MeasurePendingText();
+        }
+    }
+    int32_t pendingIndex = context->pendingTextMeasurements.length;
+    int32_t firstRequestIndex = context->textMeasurementRequests.length;
+    Clay__TextMeasurementRequestArray_Add(&context->textMeasurementRequests, CLAY__INIT(Clay__TextMeasurementRequest) { .pendingIndex = pendingIndex, .startOffset = -1 });
     int32_t start = 0;
-    int32_t end = 0;
-    float lineWidth = 0;
-    float measuredWidth = 0;
-    float measuredHeight = 0;
-    float spaceWidth = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, config, context->mesureTextUserData).width;
     Clay__MeasuredWord tempWord = { .next = -1 };
     Clay__MeasuredWord *previousWord = &tempWord;
-    while (end < text->length) {
-        if (context->measuredWords.length == context->measuredWords.capacity - 1) {
-            if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
-                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
-                    .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
-                    .userData = context->errorHandler.userData });
-                context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+    // Delimiters are located in bulk first, so the loop below runs once per word rather than once per character.
+    // Words are only split out here, their widths are filled in by Clay__MeasurePendingText.
+    Clay__int32_tArray *boundaries = &context->measureTextWordBoundaries;
+    int32_t scanPosition = 0;
+    while (scanPosition < text->length) {
+        scanPosition = Clay__ScanWordBoundaries(text->chars, scanPosition, text->length, boundaries);
+        for (int32_t boundaryIndex = 0; boundaryIndex < boundaries->length; ++boundaryIndex) {
+            if (Clay__MeasuredWordsCapacityExceeded()) {
+                context->textMeasurementRequests.length = firstRequestIndex;
+                return &Clay__MeasureTextCacheItem_DEFAULT;
             }
-            return &Clay__MeasureTextCacheItem_DEFAULT;
-        }
-        char current = text->chars[end];
-        if (current == ' ' || current == '\n') {
+            int32_t end = boundaries->internalArray[boundaryIndex];
             int32_t length = end - start;
-            Clay_Dimensions dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = length, .chars = &text->chars[start], .baseChars = text->chars }, config, context->mesureTextUserData);
-            measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
-            if (current == ' ') {
-                dimensions.width += spaceWidth;
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-            }
-            if (current == '\n') {
+            Clay__TextMeasurementRequestArray_Add(&context->textMeasurementRequests, CLAY__INIT(Clay__TextMeasurementRequest) { .pendingIndex = pendingIndex, .startOffset = start, .length = length });
+            if (text->chars[end] == ' ') {
+                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = 0, .next = -1 }, previousWord);
+            } else {
                 if (length > 0) {
-                    previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width, .next = -1 }, previousWord);
+                    previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = 0, .next = -1 }, previousWord);
                 }
                 previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-                measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
                 measured->containsNewlines = true;
-                lineWidth = 0;
             }
             start = end + 1;
         }
-        end++;
     }
-    if (end - start > 0) {
-        Clay_Dimensions dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = end - start, .chars = &text->chars[start], .baseChars = text->chars }, config, context->mesureTextUserData);
-        Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width, .next = -1 }, previousWord);
-        lineWidth += dimensions.width;
-        measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
+    if (text->length - start > 0) {
+        if (Clay__MeasuredWordsCapacityExceeded()) {
+            context->textMeasurementRequests.length = firstRequestIndex;
+            return &Clay__MeasureTextCacheItem_DEFAULT;
+        }
+        Clay__TextMeasurementRequestArray_Add(&context->textMeasurementRequests, CLAY__INIT(Clay__TextMeasurementRequest) { .pendingIndex = pendingIndex, .startOffset = start, .length = text->length - start });
+        Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = text->length - start, .width = 0, .next = -1 }, previousWord);
     }
-    measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
 
     measured->measuredWordsStartIndex = tempWord.next;
-    measured->unwrappedDimensions.width = measuredWidth;
-    measured->unwrappedDimensions.height = measuredHeight;
+    measured->measurementPending = true;
+    Clay__PendingTextMeasurementArray_Add(&context->pendingTextMeasurements, CLAY__INIT(Clay__PendingTextMeasurement) { .measured = measured, .chars = text->chars, .textLength = text->length, .config = config });
 
     if (elementIndexPrevious != 0) {
         Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious)->nextIndex = newItemIndex;
     } else {
         context->measureTextHashMap.internalArray[hashBucket] = newItemIndex;
     }
+    // Outside of layout declaration with a parallel function set, text is measured straight away
+    if (!context->measureTextDeferred) {
+        Clay__MeasurePendingText();
+    }
     return measured;
 }
 
@@ -1185,28 +1702,166 @@ bool Clay__PointIsInsideRect(Clay_Vector2 point, Clay_BoundingBox rect) {
     return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
 }
 
+// Element ids are already hashes, folding the high half in lets every bit have a say in the bucket
+uint32_t Clay__LayoutElementHashMapBucket(Clay_ElementIdValue id, uint32_t mask) {
+#ifdef CLAY_64BIT_IDS
+    id ^= id >> 32;
+#endif
+    return (uint32_t)(id ^ (id >> 16)) & mask;
+}
+
+// Searching for an id stops at the first empty slot, or at the first slot that's closer to its own bucket than the id would be at
+// that point. With the slots in Robin Hood order, see Clay__AddHashMapItem, the id can't be any further along.
+Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(Clay_ElementIdValue id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    uint32_t slotIndex = Clay__LayoutElementHashMapBucket(id, mask);
+    for (uint32_t distance = 0; slots[slotIndex].id != 0; ++distance) {
+        if (slots[slotIndex].id == id) {
+            return Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, slots[slotIndex].itemIndex);
+        }
+        if (((slotIndex - Clay__LayoutElementHashMapBucket(slots[slotIndex].id, mask)) & mask) < distance) {
+            break;
+        }
+        slotIndex = (slotIndex + 1) & mask;
+    }
+    return &Clay_LayoutElementHashMapItem_DEFAULT;
+}
+
+// Elements with a duplicate ID aren't linked to a hash map item, and fall back to looking it up
+Clay_LayoutElementHashMapItem *Clay__GetLayoutElementHashMapItem(int32_t layoutElementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *mapItem = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, layoutElementIndex)->hashMapItem;
+    return mapItem ? mapItem : Clay__GetHashMapItem(Clay_LayoutElementArray_Get(&context->layoutElements, layoutElementIndex)->id);
+}
+
+// The element's scroll data, or NULL if it doesn't have any. The index the hash item keeps goes stale when the entry is removed
+// or another element's takes its place, so the entry there has to still carry the element's id.
+Clay__ScrollContainerDataInternal *Clay__GetItemScrollContainerData(Clay_LayoutElementHashMapItem *hashItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (hashItem->elementId.id != 0 && hashItem->scrollContainerDataIndex < context->scrollContainerDatas.length) {
+        Clay__ScrollContainerDataInternal *scrollData = &context->scrollContainerDatas.internalArray[hashItem->scrollContainerDataIndex];
+        if (scrollData->elementId == hashItem->elementId.id) {
+            return scrollData;
+        }
+    }
+    return CLAY__NULL;
+}
+
+// Moves the last entry into the removed one's place, and tells its element where it went
+void Clay__RemoveScrollContainerData(int32_t index) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, index);
+    if (index < context->scrollContainerDatas.length) {
+        Clay_LayoutElementHashMapItem *movedItem = Clay__GetHashMapItem(context->scrollContainerDatas.internalArray[index].elementId);
+        if (movedItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+            movedItem->scrollContainerDataIndex = index;
+        }
+    }
+}
+
+// Takes an element's item out of the hash map and puts it on the free list. The ids after its slot that had been pushed along
+// past their bucket move back one each, which keeps the Robin Hood order without leaving tombstones behind.
+void Clay__RemoveHashMapItem(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, itemIndex);
+    // Scroll data goes with the element, so there's never more of it than there are items
+    if (Clay__GetItemScrollContainerData(hashItem)) {
+        Clay__RemoveScrollContainerData(hashItem->scrollContainerDataIndex);
+    }
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    uint32_t slotIndex = Clay__LayoutElementHashMapBucket(hashItem->elementId.id, mask);
+    while (slots[slotIndex].itemIndex != itemIndex || slots[slotIndex].id != hashItem->elementId.id) {
+        slotIndex = (slotIndex + 1) & mask;
+    }
+    uint32_t nextSlotIndex = (slotIndex + 1) & mask;
+    while (slots[nextSlotIndex].id != 0 && Clay__LayoutElementHashMapBucket(slots[nextSlotIndex].id, mask) != nextSlotIndex) {
+        slots[slotIndex] = slots[nextSlotIndex];
+        slotIndex = nextSlotIndex;
+        nextSlotIndex = (nextSlotIndex + 1) & mask;
+    }
+    slots[slotIndex] = CLAY__INIT(Clay__LayoutElementHashMapSlot) CLAY__DEFAULT_STRUCT;
+    // The debug data stays with the item, it's handed to whichever element takes the item next
+    *hashItem = CLAY__INIT(Clay_LayoutElementHashMapItem) { .debugData = hashItem->debugData };
+    Clay__int32_tArray_Add(&context->layoutElementsHashMapInternalFreeList, itemIndex);
+}
+
+// Reclaims the items of elements that haven't been declared for the last few frames, the same age the measure text cache evicts
+// at. Only itemCount items are looked at per call, carrying on from where the last call stopped, so that over a number of frames
+// the whole map gets looked over without any one frame paying for all of it.
+void Clay__SweepLayoutElementHashMap(int32_t itemCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementHashMapItemArray *items = &context->layoutElementsHashMapInternal;
+    itemCount = CLAY__MIN(itemCount, items->length);
+    for (int32_t i = 0; i < itemCount; ++i) {
+        if (context->layoutElementsHashMapSweepIndex >= items->length) {
+            context->layoutElementsHashMapSweepIndex = 0;
+        }
+        Clay_LayoutElementHashMapItem *hashItem = &items->internalArray[context->layoutElementsHashMapSweepIndex];
+        // Items declared this frame are a generation ahead, which the subtraction alone would wrap round and count as stale
+        if (hashItem->elementId.id != 0 && hashItem->generation <= context->generation && context->generation - hashItem->generation > 2) {
+            Clay__RemoveHashMapItem(context->layoutElementsHashMapSweepIndex);
+        }
+        context->layoutElementsHashMapSweepIndex++;
+    }
+}
+
+// Slots are kept in Robin Hood order: an id is never further from its bucket than the ids in the slots it had to probe past were
+// from theirs.
 Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Clay_LayoutElement* layoutElement) {
     Clay_Context* context = Clay_GetCurrentContext();
-    if (context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1) {
-        return NULL;
+    if (context->layoutElementsHashMapInternalFreeList.length == 0 && context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1) {
+        // Out of items before the sweep has got round to the stale ones, so go looking for them all now. That's only worth
+        // doing once per frame, if it turns up nothing every element in the map is still in use.
+        if (context->layoutElementsHashMapFullSweepGeneration == context->generation) {
+            return NULL;
+        }
+        context->layoutElementsHashMapFullSweepGeneration = context->generation;
+        Clay__SweepLayoutElementHashMap(context->layoutElementsHashMapInternal.length);
+        if (context->layoutElementsHashMapInternalFreeList.length == 0) {
+            return NULL;
+        }
     }
-    Clay_LayoutElementHashMapItem item = { .elementId = elementId, .layoutElement = layoutElement, .nextIndex = -1, .generation = context->generation + 1 };
-    uint32_t hashBucket = elementId.id % context->layoutElementsHashMap.capacity;
-    int32_t hashItemPrevious = -1;
-    int32_t hashItemIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (hashItemIndex != -1) { // Just replace collision, not a big deal - leave it up to the end user
-        Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemIndex);
-        if (hashItem->elementId.id == elementId.id) { // Collision - resolve based on generation
-            item.nextIndex = hashItem->nextIndex;
+    Clay_LayoutElementHashMapItem item = { .elementId = elementId, .layoutElement = layoutElement, .generation = context->generation + 1 };
+    Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, (int32_t)(layoutElement - context->layoutElements.internalArray));
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    uint32_t slotIndex = Clay__LayoutElementHashMapBucket(elementId.id, mask);
+    uint32_t distance = 0;
+    while (slots[slotIndex].id != 0 && ((slotIndex - Clay__LayoutElementHashMapBucket(slots[slotIndex].id, mask)) & mask) >= distance) {
+        if (slots[slotIndex].id == elementId.id) { // Collision - resolve based on generation
+            Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, slots[slotIndex].itemIndex);
+            // An element that hashed a different base, offset or length of string is a different element whose id happens to hash
+            // to the same value. The string from an earlier layout may not be around any more, so its characters can only be
+            // compared against one declared during this layout. Two strings of the same length hashed with the same offset, as
+            // with most CLAY_ID collisions, can't be told apart until then.
+            bool sameElement = hashItem->elementId.baseId == elementId.baseId && hashItem->elementId.offset == elementId.offset && hashItem->elementId.stringId.length == elementId.stringId.length;
+            if (sameElement && hashItem->generation > context->generation) {
+                sameElement = Clay__StringEquals(hashItem->elementId.stringId, elementId.stringId);
+            }
+            if (!sameElement) {
+                context->elementIdCollisionCount++;
+            }
             if (hashItem->generation <= context->generation) { // First collision - assume this is the "same" element
-                hashItem->elementId = elementId; // Make sure to copy this across. If the stringId reference has changed, we should update the hash item to use the new one.
-                hashItem->generation = context->generation + 1;
-                hashItem->layoutElement = layoutElement;
-                hashItem->debugData->collision = false;
+                if (sameElement) {
+                    hashItem->elementId = elementId; // Make sure to copy this across. If the stringId reference has changed, we should update the hash item to use the new one.
+                    hashItem->generation = context->generation + 1;
+                    hashItem->layoutElement = layoutElement;
+                    hashItem->debugData->collision = false;
+                } else { // Start the new element over, rather than have it pick up the layout, hover and pointer state of the old one
+                    item.debugData = hashItem->debugData;
+                    *item.debugData = CLAY__INIT(Clay__DebugElementData) CLAY__DEFAULT_STRUCT;
+                    *hashItem = item;
+                }
+                fingerprint->hashMapItem = hashItem;
             } else { // Multiple collisions this frame - two elements have the same ID
                 context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                     .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
-                    .errorText = CLAY_STRING("An element with this ID was already previously declared during this layout."),
+                    .errorText = sameElement
+                        ? CLAY_STRING("An element with this ID was already previously declared during this layout.")
+                        : CLAY_STRING("Two different element IDs declared during this layout hashed to the same value. Defining CLAY_64BIT_IDS makes this vanishingly unlikely."),
                     .userData = context->errorHandler.userData });
                 if (context->debugModeEnabled) {
                     hashItem->debugData->collision = true;
@@ -1214,31 +1869,51 @@ Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Cl
             }
             return hashItem;
         }
-        hashItemPrevious = hashItemIndex;
-        hashItemIndex = hashItem->nextIndex;
+        slotIndex = (slotIndex + 1) & mask;
+        distance++;
     }
-    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Add(&context->layoutElementsHashMapInternal, item);
-    hashItem->debugData = Clay__DebugElementDataArray_Add(&context->debugElementData, CLAY__INIT(Clay__DebugElementData) CLAY__DEFAULT_STRUCT);
-    if (hashItemPrevious != -1) {
-        Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemPrevious)->nextIndex = (int32_t)context->layoutElementsHashMapInternal.length - 1;
+    Clay_LayoutElementHashMapItem *hashItem;
+    int32_t itemIndex;
+    if (context->layoutElementsHashMapInternalFreeList.length > 0) {
+        itemIndex = Clay__int32_tArray_GetValue(&context->layoutElementsHashMapInternalFreeList, context->layoutElementsHashMapInternalFreeList.length - 1);
+        context->layoutElementsHashMapInternalFreeList.length--;
+        hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, itemIndex);
+        item.debugData = hashItem->debugData;
+        *item.debugData = CLAY__INIT(Clay__DebugElementData) CLAY__DEFAULT_STRUCT;
+        *hashItem = item;
     } else {
-        context->layoutElementsHashMap.internalArray[hashBucket] = (int32_t)context->layoutElementsHashMapInternal.length - 1;
+        itemIndex = context->layoutElementsHashMapInternal.length;
+        hashItem = Clay__LayoutElementHashMapItemArray_Add(&context->layoutElementsHashMapInternal, item);
+        hashItem->debugData = Clay__DebugElementDataArray_Add(&context->debugElementData, CLAY__INIT(Clay__DebugElementData) CLAY__DEFAULT_STRUCT);
     }
+    fingerprint->hashMapItem = hashItem;
+    // Take the slot the search stopped at, and shift the ids after it along until one lands in an empty slot. The table is never
+    // more than half full, so there always is one.
+    Clay__LayoutElementHashMapSlot insertSlot = { .id = elementId.id, .itemIndex = itemIndex };
+    while (slots[slotIndex].id != 0) {
+        uint32_t slotDistance = (slotIndex - Clay__LayoutElementHashMapBucket(slots[slotIndex].id, mask)) & mask;
+        if (slotDistance < distance) {
+            Clay__LayoutElementHashMapSlot displaced = slots[slotIndex];
+            slots[slotIndex] = insertSlot;
+            insertSlot = displaced;
+            distance = slotDistance;
+        }
+        slotIndex = (slotIndex + 1) & mask;
+        distance++;
+    }
+    slots[slotIndex] = insertSlot;
     return hashItem;
 }
 
-Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(uint32_t id) {
+// Whether the id is in pointerOverIds, without searching it. Clay_SetPointerState stamps the elements it finds the pointer over.
+// Most elements asked about aren't under the pointer, and pointerOverIdBits turns nearly all of those away before the lookup.
+bool Clay__PointerOverId(Clay_ElementIdValue id) {
     Clay_Context* context = Clay_GetCurrentContext();
-    uint32_t hashBucket = id % context->layoutElementsHashMap.capacity;
-    int32_t elementIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (elementIndex != -1) {
-        Clay_LayoutElementHashMapItem *hashEntry = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, elementIndex);
-        if (hashEntry->elementId.id == id) {
-            return hashEntry;
-        }
-        elementIndex = hashEntry->nextIndex;
+    if (!(context->pointerOverIdBits & ((uint64_t)1 << (id & 63)))) {
+        return false;
     }
-    return &Clay_LayoutElementHashMapItem_DEFAULT;
+    Clay_LayoutElementHashMapItem *hashItem = Clay__GetHashMapItem(id);
+    return hashItem != &Clay_LayoutElementHashMapItem_DEFAULT && hashItem->pointerOverGeneration == context->pointerOverGeneration;
 }
 
 void Clay__GenerateIdForAnonymousElement(Clay_LayoutElement *openLayoutElement) {
@@ -1265,10 +1940,25 @@ void Clay__ElementPostConfiguration(void) {
         openLayoutElement->layoutConfig = &CLAY_LAYOUT_DEFAULT;
     }
 
-    // Loop through element configs and handle special cases
-    openLayoutElement->elementConfigs.internalArray = &context->elementConfigs.internalArray[context->elementConfigs.length];
+    // The configs are stored in the order their render commands are generated in: scroll containers first so that the clip
+    // starts before anything is drawn, borders last so that they are drawn on top, and everything else as it was declared
+    int32_t declaredConfigsStart = context->elementConfigBuffer.length - openLayoutElement->elementConfigs.length;
+    int32_t scrollConfigCount = 0, borderConfigCount = 0;
+    for (int32_t elementConfigIndex = 0; elementConfigIndex < openLayoutElement->elementConfigs.length; elementConfigIndex++) {
+        Clay__ElementConfigType type = Clay__ElementConfigArray_Get(&context->elementConfigBuffer, declaredConfigsStart + elementConfigIndex)->type;
+        scrollConfigCount += type == CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER;
+        borderConfigCount += type == CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER;
+    }
+    int32_t nextScrollSlot = 0, nextSlot = scrollConfigCount, nextBorderSlot = openLayoutElement->elementConfigs.length - borderConfigCount;
+
+    // Loop through element configs in the order they were declared and handle special cases
+    int32_t storedConfigsStart = context->elementConfigs.length;
+    openLayoutElement->elementConfigs.internalArray = &context->elementConfigs.internalArray[storedConfigsStart];
     for (int32_t elementConfigIndex = 0; elementConfigIndex < openLayoutElement->elementConfigs.length; elementConfigIndex++) {
-        Clay_ElementConfig *config = Clay__ElementConfigArray_Add(&context->elementConfigs, *Clay__ElementConfigArray_Get(&context->elementConfigBuffer, context->elementConfigBuffer.length - openLayoutElement->elementConfigs.length + elementConfigIndex));
+        Clay_ElementConfig declaredConfig = *Clay__ElementConfigArray_Get(&context->elementConfigBuffer, declaredConfigsStart + elementConfigIndex);
+        int32_t slot = declaredConfig.type == CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER ? nextScrollSlot++ : declaredConfig.type == CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER ? nextBorderSlot++ : nextSlot++;
+        Clay__ElementConfigArray_Set(&context->elementConfigs, storedConfigsStart + slot, declaredConfig);
+        Clay_ElementConfig *config = Clay__ElementConfigArray_Get(&context->elementConfigs, storedConfigsStart + slot);
         openLayoutElement->configsEnabled |= config->type;
         switch (config->type) {
             case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE:
@@ -1280,7 +1970,7 @@ void Clay__ElementPostConfiguration(void) {
                 if (!hierarchicalParent) {
                     break;
                 }
-                uint32_t clipElementId = 0;
+                Clay_ElementIdValue clipElementId = 0;
                 if (floatingConfig->parentId == 0) {
                     // If no parent id was specified, attach to the elements direct hierarchical parent
                     Clay_FloatingElementConfig newConfig = *floatingConfig;
@@ -1288,7 +1978,7 @@ void Clay__ElementPostConfiguration(void) {
                     floatingConfig = Clay__FloatingElementConfigArray_Add(&context->floatingElementConfigs, newConfig);
                     config->config.floatingElementConfig = floatingConfig;
                     if (context->openClipElementStack.length > 0) {
-                        clipElementId = Clay__int32_tArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1);
+                        clipElementId = Clay__ElementIdValueArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1);
                     }
                 } else {
                     Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingConfig->parentId);
@@ -1298,7 +1988,7 @@ void Clay__ElementPostConfiguration(void) {
                             .errorText = CLAY_STRING("A floating element was declared with a parentId, but no element with that ID was found."),
                             .userData = context->errorHandler.userData });
                     } else {
-                        clipElementId = Clay__int32_tArray_GetValue(&context->layoutElementClipElementIds, parentItem->layoutElement - context->layoutElements.internalArray);
+                        clipElementId = Clay__ElementIdValueArray_GetValue(&context->layoutElementClipElementIds, parentItem->layoutElement - context->layoutElements.internalArray);
                     }
                 }
                 Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
@@ -1310,21 +2000,19 @@ void Clay__ElementPostConfiguration(void) {
                 break;
             }
             case CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER: {
-                Clay__int32_tArray_Add(&context->openClipElementStack, (int)openLayoutElement->id);
+                Clay__ElementIdValueArray_Add(&context->openClipElementStack, openLayoutElement->id);
                 // Retrieve or create cached data to track scroll position across frames
-                Clay__ScrollContainerDataInternal *scrollOffset = CLAY__NULL;
-                for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                    Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                    if (openLayoutElement->id == mapping->elementId) {
-                        scrollOffset = mapping;
-                        scrollOffset->layoutElement = openLayoutElement;
-                        scrollOffset->openThisFrame = true;
-                    }
-                }
-                if (!scrollOffset) {
+                Clay_LayoutElementHashMapItem *hashItem = Clay__GetLayoutElementHashMapItem((int32_t)(openLayoutElement - context->layoutElements.internalArray));
+                Clay__ScrollContainerDataInternal *scrollOffset = Clay__GetItemScrollContainerData(hashItem);
+                if (scrollOffset) {
+                    scrollOffset->layoutElement = openLayoutElement;
+                    scrollOffset->openThisFrame = true;
+                } else if (hashItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+                    // Every entry belongs to a hash map item, and the array holds as many entries as there are items
+                    hashItem->scrollContainerDataIndex = context->scrollContainerDatas.length;
                     scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
                 }
-                if (context->externalScrollHandlingEnabled) {
+                if (scrollOffset && context->externalScrollHandlingEnabled) {
                     scrollOffset->scrollPosition = Clay__QueryScrollOffset(scrollOffset->elementId, context->queryScrollOffsetUserData);
                 }
                 break;
@@ -1341,76 +2029,163 @@ void Clay__ElementPostConfiguration(void) {
     context->elementConfigBuffer.length -= openLayoutElement->elementConfigs.length;
 }
 
-void Clay__CloseElement(void) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    if (context->booleanWarnings.maxElementsExceeded) {
-        return;
+#define CLAY__FINGERPRINT_SEED 14695981039346656037ull
+
+uint64_t Clay__HashFingerprintValue(uint64_t hash, uint32_t value) {
+    hash = (hash ^ value) * 1099511628211ull;
+    return hash ^ (hash >> 32);
+}
+
+uint64_t Clay__HashFingerprintFloat(uint64_t hash, float value) {
+    union { float asFloat; uint32_t asBits; } bits;
+    bits.asFloat = value;
+    return Clay__HashFingerprintValue(hash, bits.asBits);
+}
+
+uint64_t Clay__HashFingerprintId(uint64_t hash, Clay_ElementIdValue id) {
+#ifdef CLAY_64BIT_IDS
+    hash = Clay__HashFingerprintValue(hash, (uint32_t)(id >> 32));
+#endif
+    return Clay__HashFingerprintValue(hash, (uint32_t)id);
+}
+
+uint64_t Clay__HashFingerprintSizingAxis(uint64_t hash, Clay_SizingAxis sizing) {
+    hash = Clay__HashFingerprintValue(hash, sizing.type);
+    hash = Clay__HashFingerprintFloat(hash, sizing.size.minMax.min);
+    return Clay__HashFingerprintFloat(hash, sizing.size.minMax.max);
+}
+
+// Combines everything about a closed element that feeds into sizing with the fingerprints of its children
+void Clay__FingerprintLayoutElement(int32_t layoutElementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElementIndex);
+    Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, layoutElementIndex);
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+    uint64_t hash = Clay__HashFingerprintValue(CLAY__FINGERPRINT_SEED, context->layoutFingerprintEpoch);
+    hash = Clay__HashFingerprintId(hash, layoutElement->id);
+    hash = Clay__HashFingerprintValue(hash, layoutElement->configsEnabled);
+    hash = Clay__HashFingerprintSizingAxis(hash, layoutConfig->sizing.width);
+    hash = Clay__HashFingerprintSizingAxis(hash, layoutConfig->sizing.height);
+    hash = Clay__HashFingerprintValue(hash, (uint32_t)layoutConfig->padding.left | ((uint32_t)layoutConfig->padding.right << 16));
+    hash = Clay__HashFingerprintValue(hash, (uint32_t)layoutConfig->padding.top | ((uint32_t)layoutConfig->padding.bottom << 16));
+    hash = Clay__HashFingerprintValue(hash, (uint32_t)layoutConfig->childGap | ((uint32_t)layoutConfig->layoutDirection << 16));
+    hash = Clay__HashFingerprintValue(hash, (uint32_t)layoutConfig->childAlignment.x | ((uint32_t)layoutConfig->childAlignment.y << 8));
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+        hash = Clay__HashFingerprintValue(hash, (uint32_t)scrollConfig->horizontal | ((uint32_t)scrollConfig->vertical << 1));
     }
-    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay_LayoutConfig *layoutConfig = openLayoutElement->layoutConfig;
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+        Clay_ImageElementConfig *imageConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE).imageElementConfig;
+        hash = Clay__HashFingerprintFloat(hash, imageConfig->sourceDimensions.width);
+        hash = Clay__HashFingerprintFloat(hash, imageConfig->sourceDimensions.height);
+    }
+    bool reusable = fingerprint->hashMapItem != CLAY__NULL;
+    hash = Clay__HashFingerprintValue(hash, layoutElement->childrenOrTextContent.children.length);
+    for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+        Clay__LayoutElementFingerprint *childFingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, layoutElement->childrenOrTextContent.children.elements[i]);
+        hash = Clay__HashFingerprintValue(hash, (uint32_t)childFingerprint->fingerprint);
+        hash = Clay__HashFingerprintValue(hash, (uint32_t)(childFingerprint->fingerprint >> 32));
+        reusable = reusable && childFingerprint->reusable;
+    }
+    fingerprint->fingerprint = hash;
+    fingerprint->reusable = reusable;
+}
+
+// True if the element and everything inside it has the same inputs as in the previous frame, and it was given the same size along
+// the axis being laid out (and along x as well when laying out y), so its children will end up the same size as they were then.
+// Only the previous frame counts: an element that skipped frames may have had its children laid out somewhere else in the meantime.
+bool Clay__LayoutElementUnchanged(int32_t layoutElementIndex, bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, layoutElementIndex);
+    if (!fingerprint->reusable || fingerprint->hashMapItem->layoutGeneration != context->generation - 1 || fingerprint->hashMapItem->layoutFingerprint != fingerprint->fingerprint) {
+        return false;
+    }
+    Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElementIndex);
+    Clay_Dimensions previousDimensions = fingerprint->hashMapItem->layoutDimensions;
+    return layoutElement->dimensions.width == previousDimensions.width && (xAxis || layoutElement->dimensions.height == previousDimensions.height);
+}
+
+// True if every layout tree is the same as in the previous frame, so that every element will end up the size it was then. This is
+// usually the case from one frame to the next, for instance when the only thing that changed is the scroll position or a color.
+bool Clay__LayoutTreesUnchanged(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, root->layoutElementIndex);
+        if (!fingerprint->reusable || fingerprint->hashMapItem->layoutGeneration != context->generation - 1 || fingerprint->hashMapItem->layoutFingerprint != fingerprint->fingerprint) {
+            return false;
+        }
+        // Floating containers can grow to the size of their parent, which has to have been laid out last frame and still be around
+        if (root->parentId != 0) {
+            Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(root->parentId);
+            if (parentItem->generation != context->generation + 1 || parentItem->layoutGeneration != context->generation - 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Sizes an element to fit its children, then clamps it to the min and max configured in its layout
+void Clay__SizeElementToFitChildren(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
     bool elementHasScrollHorizontal = false;
     bool elementHasScrollVertical = false;
-    if (Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
         elementHasScrollHorizontal = scrollConfig->horizontal;
         elementHasScrollVertical = scrollConfig->vertical;
-        context->openClipElementStack.length--;
     }
 
-    // Attach children to the current open element
-    openLayoutElement->childrenOrTextContent.children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
+    layoutElement->dimensions = CLAY__INIT(Clay_Dimensions) CLAY__DEFAULT_STRUCT;
+    layoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) CLAY__DEFAULT_STRUCT;
     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-        openLayoutElement->dimensions.width = (float)(layoutConfig->padding.left + layoutConfig->padding.right);
-        for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.width += child->dimensions.width;
-            openLayoutElement->dimensions.height = CLAY__MAX(openLayoutElement->dimensions.height, child->dimensions.height + layoutConfig->padding.top + layoutConfig->padding.bottom);
+        layoutElement->dimensions.width = (float)(layoutConfig->padding.left + layoutConfig->padding.right);
+        for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.width += child->dimensions.width;
+            layoutElement->dimensions.height = CLAY__MAX(layoutElement->dimensions.height, child->dimensions.height + layoutConfig->padding.top + layoutConfig->padding.bottom);
             // Minimum size of child elements doesn't matter to scroll containers as they can shrink and hide their contents
             if (!elementHasScrollHorizontal) {
-                openLayoutElement->minDimensions.width += child->minDimensions.width;
+                layoutElement->minDimensions.width += child->minDimensions.width;
             }
             if (!elementHasScrollVertical) {
-                openLayoutElement->minDimensions.height = CLAY__MAX(openLayoutElement->minDimensions.height, child->minDimensions.height + layoutConfig->padding.top + layoutConfig->padding.bottom);
+                layoutElement->minDimensions.height = CLAY__MAX(layoutElement->minDimensions.height, child->minDimensions.height + layoutConfig->padding.top + layoutConfig->padding.bottom);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.width += childGap; // TODO this is technically a bug with childgap and scroll containers
-        openLayoutElement->minDimensions.width += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.width += childGap; // TODO this is technically a bug with childgap and scroll containers
+        layoutElement->minDimensions.width += childGap;
     }
     else if (layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM) {
-        openLayoutElement->dimensions.height = (float)(layoutConfig->padding.top + layoutConfig->padding.bottom);
-        for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.height += child->dimensions.height;
-            openLayoutElement->dimensions.width = CLAY__MAX(openLayoutElement->dimensions.width, child->dimensions.width + layoutConfig->padding.left + layoutConfig->padding.right);
+        layoutElement->dimensions.height = (float)(layoutConfig->padding.top + layoutConfig->padding.bottom);
+        for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.height += child->dimensions.height;
+            layoutElement->dimensions.width = CLAY__MAX(layoutElement->dimensions.width, child->dimensions.width + layoutConfig->padding.left + layoutConfig->padding.right);
             // Minimum size of child elements doesn't matter to scroll containers as they can shrink and hide their contents
             if (!elementHasScrollVertical) {
-                openLayoutElement->minDimensions.height += child->minDimensions.height;
+                layoutElement->minDimensions.height += child->minDimensions.height;
             }
             if (!elementHasScrollHorizontal) {
-                openLayoutElement->minDimensions.width = CLAY__MAX(openLayoutElement->minDimensions.width, child->minDimensions.width + layoutConfig->padding.left + layoutConfig->padding.right);
+                layoutElement->minDimensions.width = CLAY__MAX(layoutElement->minDimensions.width, child->minDimensions.width + layoutConfig->padding.left + layoutConfig->padding.right);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.height += childGap; // TODO this is technically a bug with childgap and scroll containers
-        openLayoutElement->minDimensions.height += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.height += childGap; // TODO this is technically a bug with childgap and scroll containers
+        layoutElement->minDimensions.height += childGap;
     }
 
-    context->layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
-
     // Clamp element min and max width to the values configured in the layout
     if (layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
         if (layoutConfig->sizing.width.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.width.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
-        openLayoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.width = 0;
+        layoutElement->dimensions.width = 0;
     }
 
     // Clamp element min and max height to the values configured in the layout
@@ -1418,11 +2193,61 @@ void Clay__CloseElement(void) {
         if (layoutConfig->sizing.height.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.height.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
-        openLayoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.height = 0;
+        layoutElement->dimensions.height = 0;
+    }
+}
+
+// Text elements set their flags when they're opened, see Clay__OpenTextElement
+void Clay__StoreLayoutSizingFlags(int32_t layoutElementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElementIndex);
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+    uint8_t flags = 0;
+    if (layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT && layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_FIXED) {
+        flags |= CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_X;
+    }
+    if (layoutConfig->sizing.height.type != CLAY__SIZING_TYPE_PERCENT && layoutConfig->sizing.height.type != CLAY__SIZING_TYPE_FIXED) {
+        flags |= CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_Y;
     }
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+        if (scrollConfig->horizontal) {
+            flags |= CLAY__LAYOUT_SIZING_FLAG_SCROLL_X;
+        }
+        if (scrollConfig->vertical) {
+            flags |= CLAY__LAYOUT_SIZING_FLAG_SCROLL_Y;
+        }
+    }
+    Clay__uint8_tArray_Set(&context->layoutElementSizingFlags, layoutElementIndex, flags);
+}
+
+void Clay__CloseElement(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    if (Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        context->openClipElementStack.length--;
+    }
+
+    // Attach children to the current open element
+    openLayoutElement->childrenOrTextContent.children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
+    int32_t subtreeSize = 1;
+    for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
+        int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
+        Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
+        subtreeSize += Clay__int32_tArray_GetValue(&context->layoutElementSubtreeSizes, childIndex);
+    }
+    Clay__int32_tArray_Set(&context->layoutElementSubtreeSizes, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1), subtreeSize);
+    context->layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
+
+    Clay__SizeElementToFitChildren(openLayoutElement);
+    Clay__FingerprintLayoutElement(Clay__int32_tArray_GetValue(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1));
+    Clay__StoreLayoutSizingFlags(Clay__int32_tArray_GetValue(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1));
 
     bool elementIsFloating = Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER);
 
@@ -1444,11 +2269,13 @@ void Clay__OpenElement(void) {
     }
     Clay_LayoutElement layoutElement = CLAY__DEFAULT_STRUCT;
     Clay_LayoutElementArray_Add(&context->layoutElements, layoutElement);
+    Clay__LayoutElementFingerprintArray_Set(&context->layoutElementFingerprints, context->layoutElements.length - 1, CLAY__INIT(Clay__LayoutElementFingerprint) CLAY__DEFAULT_STRUCT);
+    Clay__int32_tArray_Set(&context->layoutElementSubtreeSizes, context->layoutElements.length - 1, 1);
     Clay__int32_tArray_Add(&context->openLayoutElementStack, context->layoutElements.length - 1);
     if (context->openClipElementStack.length > 0) {
-        Clay__int32_tArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, Clay__int32_tArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1));
+        Clay__ElementIdValueArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, Clay__ElementIdValueArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1));
     } else {
-        Clay__int32_tArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, 0);
+        Clay__ElementIdValueArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, 0);
     }
 }
 
@@ -1469,16 +2296,28 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
     openLayoutElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, openLayoutElement);
     Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
-    Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
-    openLayoutElement->dimensions = textDimensions;
-    openLayoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->unwrappedDimensions.height, .height = textDimensions.height }; // TODO not sure this is the best way to decide min width for text
-    openLayoutElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&context->textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions, .elementIndex = context->layoutElements.length - 1 });
+    openLayoutElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&context->textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .elementIndex = context->layoutElements.length - 1, .measured = textMeasured });
+    // Deferred measurements leave the element zero sized for now, its dimensions are filled in by Clay__MeasurePendingText
+    if (textMeasured->measurementPending && context->deferredTextElements.length == context->deferredTextElements.capacity) {
+        Clay__MeasurePendingText();
+    }
+    if (textMeasured->measurementPending) {
+        Clay__DeferredTextElementArray_Add(&context->deferredTextElements, CLAY__INIT(Clay__DeferredTextElement) { .measured = textMeasured, .textElementDataIndex = context->textElementData.length - 1 });
+        context->textElementsDeferred = true;
+    }
+    Clay__ApplyTextMeasurement(openLayoutElement, openLayoutElement->childrenOrTextContent.textElementData, textMeasured, textConfig);
+    // The text cache id covers the string and every text config field that affects its size
+    Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, context->layoutElements.length - 1);
+    fingerprint->fingerprint = Clay__HashFingerprintValue(Clay__HashFingerprintId(Clay__HashFingerprintValue(CLAY__FINGERPRINT_SEED, context->layoutFingerprintEpoch), elementId.id), textMeasured->id);
+    fingerprint->reusable = fingerprint->hashMapItem && textMeasured != &Clay__MeasureTextCacheItem_DEFAULT;
     openLayoutElement->elementConfigs = CLAY__INIT(Clay__ElementConfigArraySlice) {
         .length = 1,
         .internalArray = Clay__ElementConfigArray_Add(&context->elementConfigs, CLAY__INIT(Clay_ElementConfig) { .type = CLAY__ELEMENT_CONFIG_TYPE_TEXT, .config = { .textElementConfig = textConfig }})
     };
     openLayoutElement->configsEnabled |= CLAY__ELEMENT_CONFIG_TYPE_TEXT;
     openLayoutElement->layoutConfig = &CLAY_LAYOUT_DEFAULT;
+    // Text sizes along both axes with the default FIT sizing, but only wrapping text can give up any of its width
+    Clay__uint8_tArray_Set(&context->layoutElementSizingFlags, context->layoutElements.length - 1, textConfig->wrapMode == CLAY_TEXT_WRAP_WORDS ? CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_X | CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_Y : 0);
     // Close the currently open element
     Clay__int32_tArray_RemoveSwapback(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1);
 }
@@ -1508,6 +2347,14 @@ void Clay__InitializeEphemeralMemory(Clay_Context* context) {
     context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementTreeRootsSortBuffer = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementCount, arena);
+    context->culledLayoutElements = Clay__LayoutElementTreeNodeArray_Allocate_Arena(maxElementCount, arena);
+    context->culledLayoutElementIndices = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerBatchTasks = Clay__PointerBatchTaskArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerBatchHits = Clay__PointerBatchTaskArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerBatchOrder = Clay__PointerBatchOrderArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerBatchOrderBuffer = Clay__PointerBatchOrderArray_Allocate_Arena(maxElementCount, arena);
+    context->visibleRectStack = Clay__BoundingBoxArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementChildren = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->textElementData = Clay__TextElementDataArray_Allocate_Arena(maxElementCount, arena);
@@ -1515,9 +2362,18 @@ void Clay__InitializeEphemeralMemory(Clay_Context* context) {
     context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(maxElementCount, arena);
     context->treeNodeVisited = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
     context->treeNodeVisited.length = context->treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
-    context->openClipElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->openClipElementStack = Clay__ElementIdValueArray_Allocate_Arena(maxElementCount, arena);
     context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->sizingScratchBuffer = Clay__floatArray_Allocate_Arena(maxElementCount * 3, arena);
+    context->layoutElementClipElementIds = Clay__ElementIdValueArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementFingerprints = Clay__LayoutElementFingerprintArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementSubtreeSizes = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementSizingFlags = Clay__uint8_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementSubtreeContained = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementSubtreeBounds = Clay__SubtreeBoundsArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementChildrenOrdered = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutSizingSubtreeRoots = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutSizingTasks = Clay__LayoutSizingTaskArray_Allocate_Arena(maxElementCount, arena);
     context->dynamicStringData = Clay__charArray_Allocate_Arena(maxElementCount, arena);
 }
 
@@ -1527,82 +2383,431 @@ void Clay__InitializePersistentMemory(Clay_Context* context) {
     int32_t maxMeasureTextCacheWordCount = context->maxMeasureTextCacheWordCount;
     Clay_Arena *arena = &context->internalArena;
     
-    context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(10, arena);
+    // Scroll data is removed along with its element's hash map item, so it can never outnumber them
+    context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementsHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    // Kept at most half full so that probe sequences stay short
+    int32_t layoutElementsHashMapCapacity = 1;
+    while (layoutElementsHashMapCapacity < maxElementCount * 2) {
+        layoutElementsHashMapCapacity *= 2;
+    }
+    context->layoutElementsHashMap = Clay__LayoutElementHashMapSlotArray_Allocate_Arena(layoutElementsHashMapCapacity, arena);
+    context->layoutElementsHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(maxElementCount, arena);
     context->measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->measuredWordsFreeList = Clay__int32_tArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
     context->measureTextHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->measuredWords = Clay__MeasuredWordArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    context->wrappedTextLinesCache = Clay__WrappedTextLineArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    context->measureTextWordBoundaries = Clay__int32_tArray_Allocate_Arena(1024, arena); // Scratch buffer, long text is scanned in several passes
+    // Text measured in one batch is limited to these sizes, larger frames are measured in several batches
+    context->pendingTextMeasurements = Clay__PendingTextMeasurementArray_Allocate_Arena(maxElementCount / 4, arena);
+    context->textMeasurementRequests = Clay__TextMeasurementRequestArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    context->deferredTextElements = Clay__DeferredTextElementArray_Allocate_Arena(maxElementCount / 4, arena);
+    context->wrappedTextLinesCacheEpoch = 1;
     context->pointerOverIds = Clay__ElementIdArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerEvents = Clay_PointerEventArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerEventTargets = Clay_PointerEventArray_Allocate_Arena(maxElementCount, arena);
+    context->pointerEventTargetsBuffer = Clay_PointerEventArray_Allocate_Arena(maxElementCount, arena);
     context->debugElementData = Clay__DebugElementDataArray_Allocate_Arena(maxElementCount, arena);
     context->arenaResetOffset = arena->nextAllocation;
 }
 
 
-void Clay__CompressChildrenAlongAxis(bool xAxis, float totalSizeToDistribute, Clay__int32_tArray resizableContainerBuffer) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    Clay__int32_tArray largestContainers = context->openClipElementStack;
+// Sorts values from largest to smallest. scratch must have room for count values.
+void Clay__SortFloatsDescending(float *values, float *scratch, int32_t count) {
+    // Insertion sort short runs, then merge runs of doubling width back and forth between the two buffers
+    const int32_t runLength = 16;
+    for (int32_t runStart = 0; runStart < count; runStart += runLength) {
+        int32_t runEnd = CLAY__MIN(runStart + runLength, count);
+        for (int32_t i = runStart + 1; i < runEnd; ++i) {
+            float value = values[i];
+            int32_t j = i;
+            for (; j > runStart && values[j - 1] < value; --j) {
+                values[j] = values[j - 1];
+            }
+            values[j] = value;
+        }
+    }
+    float *source = values;
+    float *destination = scratch;
+    for (int32_t width = runLength; width < count; width *= 2) {
+        for (int32_t left = 0; left < count; left += width * 2) {
+            int32_t middle = CLAY__MIN(left + width, count);
+            int32_t right = CLAY__MIN(left + width * 2, count);
+            int32_t i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                destination[k++] = source[i] >= source[j] ? source[i++] : source[j++];
+            }
+            while (i < middle) {
+                destination[k++] = source[i++];
+            }
+            while (j < right) {
+                destination[k++] = source[j++];
+            }
+        }
+        float *temp = source;
+        source = destination;
+        destination = temp;
+    }
+    if (source != values) {
+        for (int32_t i = 0; i < count; ++i) {
+            values[i] = source[i];
+        }
+    }
+}
 
-    while (totalSizeToDistribute > 0.1) {
-        largestContainers.length = 0;
-        float largestSize = 0;
-        float targetSize = 0;
-        for (int32_t i = 0; i < resizableContainerBuffer.length; ++i) {
-            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, i));
-            if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
-                continue;
+// Sorts tree roots from lowest to highest z index, keeping roots with the same z index in the order they were declared.
+// Roots usually arrive in order already, which is checked first. scratch must have room for every root.
+void Clay__SortTreeRootsByZIndex(Clay__LayoutElementTreeRootArray *roots, Clay__LayoutElementTreeRoot *scratch) {
+    Clay__LayoutElementTreeRoot *values = roots->internalArray;
+    int32_t count = roots->length;
+    bool sorted = true;
+    for (int32_t i = 1; i < count && sorted; ++i) {
+        sorted = values[i - 1].zIndex <= values[i].zIndex;
+    }
+    if (sorted) {
+        return;
+    }
+    // The same run and merge passes as Clay__SortFloatsDescending, which are stable as long as ties take the earlier root
+    const int32_t runLength = 16;
+    for (int32_t runStart = 0; runStart < count; runStart += runLength) {
+        int32_t runEnd = CLAY__MIN(runStart + runLength, count);
+        for (int32_t i = runStart + 1; i < runEnd; ++i) {
+            Clay__LayoutElementTreeRoot value = values[i];
+            int32_t j = i;
+            for (; j > runStart && values[j - 1].zIndex > value.zIndex; --j) {
+                values[j] = values[j - 1];
             }
-            float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
-            if ((childSize - largestSize) < 0.1 && (childSize - largestSize) > -0.1) {
-                Clay__int32_tArray_Add(&largestContainers, Clay__int32_tArray_GetValue(&resizableContainerBuffer, i));
-            } else if (childSize > largestSize) {
-                targetSize = largestSize;
-                largestSize = childSize;
-                largestContainers.length = 0;
-                Clay__int32_tArray_Add(&largestContainers, Clay__int32_tArray_GetValue(&resizableContainerBuffer, i));
+            values[j] = value;
+        }
+    }
+    Clay__LayoutElementTreeRoot *source = values;
+    Clay__LayoutElementTreeRoot *destination = scratch;
+    for (int32_t width = runLength; width < count; width *= 2) {
+        for (int32_t left = 0; left < count; left += width * 2) {
+            int32_t middle = CLAY__MIN(left + width, count);
+            int32_t right = CLAY__MIN(left + width * 2, count);
+            int32_t i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                destination[k++] = source[j].zIndex < source[i].zIndex ? source[j++] : source[i++];
             }
-            else if (childSize > targetSize) {
-                targetSize = childSize;
+            while (i < middle) {
+                destination[k++] = source[i++];
             }
+            while (j < right) {
+                destination[k++] = source[j++];
+            }
+        }
+        Clay__LayoutElementTreeRoot *temp = source;
+        source = destination;
+        destination = temp;
+    }
+    if (source != values) {
+        for (int32_t i = 0; i < count; ++i) {
+            values[i] = source[i];
+        }
+    }
+}
+
+// Shrinks the largest children down to a common size until totalSizeToDistribute has been removed, without taking any child
+// below its minimum size. Sweeping the sorted sizes and minimum sizes from largest to smallest finds that common size directly.
+// scratch must have room for three floats per child.
+void Clay__CompressChildrenAlongAxis(bool xAxis, float totalSizeToDistribute, Clay__int32_tArray resizableContainerBuffer, float *scratch) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (totalSizeToDistribute <= 0.1) {
+        return;
+    }
+    int32_t count = 0;
+    float *sizes = scratch;
+    float *minSizes = sizes + resizableContainerBuffer.length;
+    float *sortScratch = minSizes + resizableContainerBuffer.length;
+    for (int32_t i = 0; i < resizableContainerBuffer.length; ++i) {
+        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, i));
+        if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+            continue;
+        }
+        float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
+        float childMinSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
+        sizes[count] = childSize;
+        minSizes[count] = CLAY__MIN(childMinSize, childSize);
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+    Clay__SortFloatsDescending(sizes, sortScratch, count);
+    Clay__SortFloatsDescending(minSizes, sortScratch, count);
+
+    // As the target size drops, a child starts shrinking once the target passes its size and stops once it reaches its minimum
+    float targetSize = -CLAY__MAXFLOAT;
+    float currentSize = sizes[0];
+    float sizeRemoved = 0;
+    int32_t shrinkingCount = 0;
+    int32_t sizeIndex = 0;
+    int32_t minSizeIndex = 0;
+    while (minSizeIndex < count) {
+        float nextSize = sizeIndex < count ? CLAY__MAX(sizes[sizeIndex], minSizes[minSizeIndex]) : minSizes[minSizeIndex];
+        float sizeRemovedAtNext = sizeRemoved + (currentSize - nextSize) * (float)shrinkingCount;
+        if (shrinkingCount > 0 && sizeRemovedAtNext >= totalSizeToDistribute) {
+            targetSize = currentSize - (totalSizeToDistribute - sizeRemoved) / (float)shrinkingCount;
+            break;
+        }
+        sizeRemoved = sizeRemovedAtNext;
+        currentSize = nextSize;
+        if (sizeIndex < count && sizes[sizeIndex] >= minSizes[minSizeIndex]) {
+            shrinkingCount++;
+            sizeIndex++;
+        } else {
+            shrinkingCount--;
+            minSizeIndex++;
+        }
+    }
+
+    for (int32_t i = 0; i < resizableContainerBuffer.length; ++i) {
+        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, i));
+        if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+            continue;
+        }
+        float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
+        float childMinSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
+        if (*childSize > targetSize && *childSize > childMinSize) {
+            *childSize = CLAY__MAX(childMinSize, targetSize);
         }
+    }
+}
 
-        if (largestContainers.length == 0) {
-            return;
+// Queues a child container to have its own children sized. While the top of a large layout is being split up, children with
+// small enough subtrees are set aside to be sized as tasks instead.
+void Clay__AddSubtreeToSize(int32_t layoutElementIndex, Clay__int32_tArray *bfsBuffer, int32_t taskElementCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (taskElementCount > 0 && Clay__int32_tArray_GetValue(&context->layoutElementSubtreeSizes, layoutElementIndex) <= taskElementCount) {
+        Clay__int32_tArray_Add(&context->layoutSizingSubtreeRoots, layoutElementIndex);
+    } else {
+        Clay__int32_tArray_Add(bfsBuffer, layoutElementIndex);
+    }
+}
+
+// Sizes everything below an element that has already been sized itself, breadth first so that every parent is sized before
+// its children. Only the subtree and the given buffers are written, so separate subtrees can be sized at the same time.
+// scratch must have room for three floats per element in the subtree.
+void Clay__SizeSubtreeAlongAxis(int32_t subtreeRootIndex, bool xAxis, Clay__int32_tArray bfsBuffer, Clay__int32_tArray resizableContainerBuffer, float *scratch, int32_t taskElementCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint8_t resizableFlag = xAxis ? CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_X : CLAY__LAYOUT_SIZING_FLAG_RESIZABLE_Y;
+    bfsBuffer.length = 0;
+    Clay__int32_tArray_Add(&bfsBuffer, subtreeRootIndex);
+    for (int32_t i = 0; i < bfsBuffer.length; ++i) {
+        int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
+        Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
+        // Nothing that feeds into this subtree's sizes has changed since the previous frame, so its children keep their previous sizes
+        if (Clay__LayoutElementUnchanged(parentIndex, xAxis)) {
+            for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                Clay_Dimensions previousDimensions = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, childElementIndex)->hashMapItem->layoutDimensions;
+                if (xAxis) {
+                    childElement->dimensions.width = previousDimensions.width;
+                } else {
+                    childElement->dimensions.height = previousDimensions.height;
+                }
+                if (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && childElement->childrenOrTextContent.children.length > 0) {
+                    Clay__AddSubtreeToSize(childElementIndex, &bfsBuffer, taskElementCount);
+                }
+            }
+            continue;
         }
+        Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
+        int32_t growContainerCount = 0;
+        float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
+        float parentPadding = (float)(xAxis ? (parent->layoutConfig->padding.left + parent->layoutConfig->padding.right) : (parent->layoutConfig->padding.top + parent->layoutConfig->padding.bottom));
+        float innerContentSize = 0, growContainerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
+        bool sizingAlongAxis = (xAxis && parentStyleConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentStyleConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
+        bool parentScrolls = Clay__uint8_tArray_GetValue(&context->layoutElementSizingFlags, parentIndex) & (xAxis ? CLAY__LAYOUT_SIZING_FLAG_SCROLL_X : CLAY__LAYOUT_SIZING_FLAG_SCROLL_Y);
+        resizableContainerBuffer.length = 0;
+        float parentChildGap = parentStyleConfig->childGap;
+
+        for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+            int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+            Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
+            float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
 
-        targetSize = CLAY__MAX(targetSize, (largestSize * largestContainers.length) - totalSizeToDistribute) / largestContainers.length;
+            if (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && childElement->childrenOrTextContent.children.length > 0) {
+                Clay__AddSubtreeToSize(childElementIndex, &bfsBuffer, taskElementCount);
+            }
+
+            if (Clay__uint8_tArray_GetValue(&context->layoutElementSizingFlags, childElementIndex) & resizableFlag) {
+                Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
+            }
 
-        for (int32_t childOffset = 0; childOffset < largestContainers.length; childOffset++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&largestContainers, childOffset);
-            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
+            if (sizingAlongAxis) {
+                innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
+                if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                    growContainerContentSize += childSize;
+                    growContainerCount++;
+                }
+                if (childOffset > 0) {
+                    innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
+                    totalPaddingAndChildGaps += parentChildGap;
+                }
+            } else {
+                innerContentSize = CLAY__MAX(childSize, innerContentSize);
+            }
+        }
+
+        // Expand percentage containers to size
+        for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+            int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+            Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
             float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-            float childMinSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
-            float oldChildSize = *childSize;
-            *childSize = CLAY__MAX(childMinSize, targetSize);
-            totalSizeToDistribute -= (oldChildSize - *childSize);
-            if (*childSize == childMinSize) {
-                for (int32_t i = 0; i < resizableContainerBuffer.length; i++) {
-                    if (Clay__int32_tArray_GetValue(&resizableContainerBuffer, i) == childIndex) {
-                        Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, i);
-                        break;
+            if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
+                *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
+                if (sizingAlongAxis) {
+                    innerContentSize += *childSize;
+                }
+            }
+        }
+
+        if (sizingAlongAxis) {
+            float sizeToDistribute = parentSize - parentPadding - innerContentSize;
+            // The content is too large, compress the children as much as possible
+            if (sizeToDistribute < 0) {
+                // If the parent can scroll in the axis direction in this direction, don't compress children, just leave them alone
+                if (parentScrolls) {
+                    continue;
+                }
+                // Scrolling containers preferentially compress before others
+                Clay__CompressChildrenAlongAxis(xAxis, -sizeToDistribute, resizableContainerBuffer, scratch);
+            // The content is too small, allow SIZING_GROW containers to expand
+            } else if (sizeToDistribute > 0 && growContainerCount > 0) {
+                float targetSize = (sizeToDistribute + growContainerContentSize) / (float)growContainerCount;
+                float *growMinSizes = scratch;
+                int32_t growMinSizeCount = 0;
+                bool anyMinSizeAboveTarget = false;
+                for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
+                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
+                    Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
+                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                        float minSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
+                        growMinSizes[growMinSizeCount++] = minSize;
+                        anyMinSizeAboveTarget = anyMinSizeAboveTarget || targetSize < minSize;
+                    }
+                }
+                // Children whose min size is above the even share keep their size, which lowers the share left for the rest.
+                // Taking them in order of descending min size settles every clamp in a single sweep.
+                if (anyMinSizeAboveTarget) {
+                    Clay__SortFloatsDescending(growMinSizes, growMinSizes + growMinSizeCount, growMinSizeCount);
+                    for (int32_t i = 0; i < growMinSizeCount && targetSize < growMinSizes[i]; i++) {
+                        growContainerContentSize -= growMinSizes[i];
+                        growContainerCount--;
+                        targetSize = (sizeToDistribute + growContainerContentSize) / (float)growContainerCount;
                     }
                 }
+                for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
+                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
+                    Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
+                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                        float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
+                        float minSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
+                        if (targetSize >= minSize) {
+                            *childSize = targetSize;
+                        }
+                    }
+                }
+            }
+        // Sizing along the non layout axis ("off axis")
+        } else {
+            for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
+                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
+                float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
+
+                if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+                    continue; // Currently we don't support resizing aspect ratio images on the Y axis because it would break the ratio
+                }
+
+                // If we're laying out the children of a scroll panel, grow containers expand to the height of the inner content, not the outer container
+                float maxSize = parentSize - parentPadding;
+                if (parentScrolls) {
+                    maxSize = CLAY__MAX(maxSize, innerContentSize);
+                }
+                if (childSizing.type == CLAY__SIZING_TYPE_FIT) {
+                    *childSize = CLAY__MAX(childSizing.size.minMax.min, CLAY__MIN(*childSize, maxSize));
+                } else if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                    *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
+                }
             }
         }
     }
 }
 
+#define CLAY__LAYOUT_SIZING_TASK_COUNT 64 // Large layouts are split into about this many tasks, so that uneven tasks still balance out across threads
+#define CLAY__LAYOUT_SIZING_TASK_MIN_ELEMENTS 256 // Smaller subtrees aren't worth handing to another thread
+
+typedef struct {
+    Clay_Context *context;
+    bool xAxis;
+} Clay__LayoutSizingTaskData;
+
+// Runs on worker threads, so it must only touch its own subtrees and its own slice of the sizing buffers
+void Clay__RunLayoutSizingTask(int32_t taskIndex, void *taskData) {
+    Clay__LayoutSizingTaskData *data = (Clay__LayoutSizingTaskData *)taskData;
+    Clay_Context *context = data->context;
+    Clay__LayoutSizingTask *task = &context->layoutSizingTasks.internalArray[taskIndex];
+    Clay__int32_tArray bfsBuffer = CLAY__INIT(Clay__int32_tArray) { .capacity = task->scratchLength, .length = 0, .internalArray = context->layoutElementChildrenBuffer.internalArray + task->scratchOffset };
+    Clay__int32_tArray resizableContainerBuffer = CLAY__INIT(Clay__int32_tArray) { .capacity = task->scratchLength, .length = 0, .internalArray = context->openLayoutElementStack.internalArray + task->scratchOffset };
+    float *scratch = context->sizingScratchBuffer.internalArray + task->scratchOffset * 3;
+    for (int32_t i = task->subtreeRootsStart; i < task->subtreeRootsEnd; ++i) {
+        Clay__SizeSubtreeAlongAxis(context->layoutSizingSubtreeRoots.internalArray[i], data->xAxis, bfsBuffer, resizableContainerBuffer, scratch, 0);
+    }
+}
+
+// Groups the collected subtrees into tasks of at least taskElementCount elements each and sizes them. The subtrees don't
+// overlap, so every task gets a separate slice of the sizing buffers and the result doesn't depend on how they are scheduled.
+void Clay__RunLayoutSizingTasks(bool xAxis, int32_t taskElementCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray *subtreeRoots = &context->layoutSizingSubtreeRoots;
+    Clay__LayoutSizingTaskArray *tasks = &context->layoutSizingTasks;
+    tasks->length = 0;
+    int32_t scratchOffset = 0;
+    for (int32_t i = 0; i < subtreeRoots->length;) {
+        Clay__LayoutSizingTask task = { .subtreeRootsStart = i, .subtreeRootsEnd = i, .scratchOffset = scratchOffset, .scratchLength = 0 };
+        while (task.subtreeRootsEnd < subtreeRoots->length && task.scratchLength < taskElementCount) {
+            task.scratchLength += Clay__int32_tArray_GetValue(&context->layoutElementSubtreeSizes, Clay__int32_tArray_GetValue(subtreeRoots, task.subtreeRootsEnd));
+            task.subtreeRootsEnd++;
+        }
+        scratchOffset += task.scratchLength;
+        i = task.subtreeRootsEnd;
+        Clay__LayoutSizingTaskArray_Add(tasks, task);
+    }
+    Clay__LayoutSizingTaskData taskData = { context, xAxis };
+    #ifndef CLAY_WASM
+    if (tasks->length > 1) {
+        Clay__LayoutParallel(Clay__RunLayoutSizingTask, &taskData, tasks->length, context->layoutParallelUserData);
+    } else
+    #endif
+    {
+        for (int32_t i = 0; i < tasks->length; ++i) {
+            Clay__RunLayoutSizingTask(i, &taskData);
+        }
+    }
+    subtreeRoots->length = 0;
+}
+
 void Clay__SizeContainersAlongAxis(bool xAxis) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__int32_tArray bfsBuffer = context->layoutElementChildrenBuffer;
     Clay__int32_tArray resizableContainerBuffer = context->openLayoutElementStack;
+    float *scratch = context->sizingScratchBuffer.internalArray;
+    int32_t taskElementCount = CLAY__MAX(context->layoutElements.length / CLAY__LAYOUT_SIZING_TASK_COUNT, CLAY__LAYOUT_SIZING_TASK_MIN_ELEMENTS);
+    bool parallel = false;
+    #ifndef CLAY_WASM
+    parallel = Clay__LayoutParallel != NULL && context->layoutElements.length >= taskElementCount * 2;
+    #endif
     for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
-        bfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
         Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
-        Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
 
         // Size floating containers to their parents
         if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER)) {
@@ -1610,6 +2815,10 @@ void Clay__SizeContainersAlongAxis(bool xAxis) {
             Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingElementConfig->parentId);
             if (parentItem) {
                 Clay_LayoutElement *parentLayoutElement = parentItem->layoutElement;
+                // The parent may be inside a subtree that hasn't been sized yet
+                if (parallel && (xAxis ? rootElement->layoutConfig->sizing.width.type : rootElement->layoutConfig->sizing.height.type) == CLAY__SIZING_TYPE_GROW) {
+                    Clay__RunLayoutSizingTasks(xAxis, taskElementCount);
+                }
                 if (rootElement->layoutConfig->sizing.width.type == CLAY__SIZING_TYPE_GROW) {
                     rootElement->dimensions.width = parentLayoutElement->dimensions.width;
                 }
@@ -1622,122 +2831,16 @@ void Clay__SizeContainersAlongAxis(bool xAxis) {
         rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->layoutConfig->sizing.width.size.minMax.min), rootElement->layoutConfig->sizing.width.size.minMax.max);
         rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->layoutConfig->sizing.height.size.minMax.min), rootElement->layoutConfig->sizing.height.size.minMax.max);
 
-        for (int32_t i = 0; i < bfsBuffer.length; ++i) {
-            int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
-            Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
-            Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
-            int32_t growContainerCount = 0;
-            float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
-            float parentPadding = (float)(xAxis ? (parent->layoutConfig->padding.left + parent->layoutConfig->padding.right) : (parent->layoutConfig->padding.top + parent->layoutConfig->padding.bottom));
-            float innerContentSize = 0, growContainerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
-            bool sizingAlongAxis = (xAxis && parentStyleConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentStyleConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
-            resizableContainerBuffer.length = 0;
-            float parentChildGap = parentStyleConfig->childGap;
-
-            for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
-                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
-
-                if (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && childElement->childrenOrTextContent.children.length > 0) {
-                    Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
-                }
-
-                if (childSizing.type != CLAY__SIZING_TYPE_PERCENT && childSizing.type != CLAY__SIZING_TYPE_FIXED && (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || (Clay__FindElementConfigWithType(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS))) {
-                    Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
-                }
-
-                if (sizingAlongAxis) {
-                    innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        growContainerContentSize += childSize;
-                        growContainerCount++;
-                    }
-                    if (childOffset > 0) {
-                        innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
-                        totalPaddingAndChildGaps += parentChildGap;
-                    }
-                } else {
-                    innerContentSize = CLAY__MAX(childSize, innerContentSize);
-                }
-            }
-
-            // Expand percentage containers to size
-            for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
-                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
-                    *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
-                    if (sizingAlongAxis) {
-                        innerContentSize += *childSize;
-                    }
-                }
-            }
-
-            if (sizingAlongAxis) {
-                float sizeToDistribute = parentSize - parentPadding - innerContentSize;
-                // The content is too large, compress the children as much as possible
-                if (sizeToDistribute < 0) {
-                    // If the parent can scroll in the axis direction in this direction, don't compress children, just leave them alone
-                    if (Clay__ElementHasConfig(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                        Clay_ScrollElementConfig *scrollElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                        if (((xAxis && scrollElementConfig->horizontal) || (!xAxis && scrollElementConfig->vertical))) {
-                            continue;
-                        }
-                    }
-                    // Scrolling containers preferentially compress before others
-                    Clay__CompressChildrenAlongAxis(xAxis, -sizeToDistribute, resizableContainerBuffer);
-                // The content is too small, allow SIZING_GROW containers to expand
-                } else if (sizeToDistribute > 0 && growContainerCount > 0) {
-                    float targetSize = (sizeToDistribute + growContainerContentSize) / (float)growContainerCount;
-                    for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
-                        Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                        if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                            float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                            float *minSize = xAxis ? &childElement->minDimensions.width : &childElement->minDimensions.height;
-                            if (targetSize < *minSize) {
-                                growContainerContentSize -= *minSize;
-                                Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childOffset);
-                                growContainerCount--;
-                                targetSize = (sizeToDistribute + growContainerContentSize) / (float)growContainerCount;
-                                childOffset = -1;
-                                continue;
-                            }
-                            *childSize = targetSize;
-                        }
-                    }
-                }
-            // Sizing along the non layout axis ("off axis")
-            } else {
-                for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
-                    Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                    float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-
-                    if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
-                        continue; // Currently we don't support resizing aspect ratio images on the Y axis because it would break the ratio
-                    }
-
-                    // If we're laying out the children of a scroll panel, grow containers expand to the height of the inner content, not the outer container
-                    float maxSize = parentSize - parentPadding;
-                    if (Clay__ElementHasConfig(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                        Clay_ScrollElementConfig *scrollElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                        if (((xAxis && scrollElementConfig->horizontal) || (!xAxis && scrollElementConfig->vertical))) {
-                            maxSize = CLAY__MAX(maxSize, innerContentSize);
-                        }
-                    }
-                    if (childSizing.type == CLAY__SIZING_TYPE_FIT) {
-                        *childSize = CLAY__MAX(childSizing.size.minMax.min, CLAY__MIN(*childSize, maxSize));
-                    } else if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
-                    }
-                }
-            }
+        // Everything below an element only depends on its own size. When the layout is being split up, the top of the tree is
+        // sized here and subtrees that are small enough to be handed out as tasks are set aside.
+        if (parallel && Clay__int32_tArray_GetValue(&context->layoutElementSubtreeSizes, (int32_t)root->layoutElementIndex) <= taskElementCount) {
+            Clay__int32_tArray_Add(&context->layoutSizingSubtreeRoots, (int32_t)root->layoutElementIndex);
+            continue;
         }
+        Clay__SizeSubtreeAlongAxis((int32_t)root->layoutElementIndex, xAxis, bfsBuffer, resizableContainerBuffer, scratch, parallel ? taskElementCount : 0);
+    }
+    if (parallel) {
+        Clay__RunLayoutSizingTasks(xAxis, taskElementCount);
     }
 }
 
@@ -1787,37 +2890,346 @@ void Clay__AddRenderCommand(Clay_RenderCommand renderCommand) {
     }
 }
 
-bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
+// The visible rect is the screen, cut down to the inside of any scroll containers the element is in
+bool Clay__ElementIsOutsideVisibleRect(Clay_BoundingBox *boundingBox, Clay_BoundingBox *visibleRect) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->disableCulling) {
         return false;
     }
 
-    return (boundingBox->x > (float)context->layoutDimensions.width) ||
-           (boundingBox->y > (float)context->layoutDimensions.height) ||
-           (boundingBox->x + boundingBox->width < 0) ||
-           (boundingBox->y + boundingBox->height < 0);
+    return (visibleRect->width < 0 || visibleRect->height < 0) ||
+           (boundingBox->x > visibleRect->x + visibleRect->width) ||
+           (boundingBox->y > visibleRect->y + visibleRect->height) ||
+           (boundingBox->x + boundingBox->width < visibleRect->x) ||
+           (boundingBox->y + boundingBox->height < visibleRect->y);
+}
+
+bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BoundingBox screen = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
+    return Clay__ElementIsOutsideVisibleRect(boundingBox, &screen);
+}
+
+// The size is negative when the boxes don't overlap, which leaves nothing visible inside the result
+Clay_BoundingBox Clay__IntersectBoundingBoxes(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float x = CLAY__MAX(a.x, b.x);
+    float y = CLAY__MAX(a.y, b.y);
+    return CLAY__INIT(Clay_BoundingBox) { x, y, CLAY__MIN(a.x + a.width, b.x + b.width) - x, CLAY__MIN(a.y + a.height, b.y + b.height) - y };
+}
+
+// Returns how far a scroll container's children are moved by scrolling, or zero for any other element. Also stores the
+// container's bounding box with its scroll data if one is given.
+Clay_Vector2 Clay__GetScrollOffset(Clay_LayoutElement *layoutElement, Clay_BoundingBox *boundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_Vector2 scrollOffset = CLAY__DEFAULT_STRUCT;
+    if (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        return scrollOffset;
+    }
+    Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+    Clay__ScrollContainerDataInternal *mapping = Clay__GetItemScrollContainerData(Clay__GetLayoutElementHashMapItem((int32_t)(layoutElement - context->layoutElements.internalArray)));
+    // A duplicate of the container's id declared later this frame takes the scroll data over
+    if (mapping && mapping->layoutElement == layoutElement) {
+        if (boundingBox) {
+            mapping->boundingBox = *boundingBox;
+        }
+        if (scrollConfig->horizontal) {
+            scrollOffset.x = mapping->scrollPosition.x;
+        }
+        if (scrollConfig->vertical) {
+            scrollOffset.y = mapping->scrollPosition.y;
+        }
+        if (context->externalScrollHandlingEnabled) {
+            scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
+        }
+    }
+    return scrollOffset;
+}
+
+// Positions the children of a (non text) element inside it, then adds them to the end of the buffer in reverse so that
+// taking them back off the end visits them in layout order
+void Clay__AddChildTreeNodes(Clay__LayoutElementTreeNodeArray *buffer, Clay__LayoutElementTreeNode parentNode, Clay_Vector2 scrollOffset) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *currentElement = parentNode.layoutElement;
+    Clay_LayoutConfig *layoutConfig = currentElement->layoutConfig;
+
+    // Setup initial on-axis alignment
+    Clay_Dimensions contentSize = {0,0};
+    if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+        for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+            contentSize.width += childElement->dimensions.width;
+            contentSize.height = CLAY__MAX(contentSize.height, childElement->dimensions.height);
+        }
+        contentSize.width += (float)(CLAY__MAX(currentElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        float extraSpace = currentElement->dimensions.width - (float)(layoutConfig->padding.left + layoutConfig->padding.right) - contentSize.width;
+        switch (layoutConfig->childAlignment.x) {
+            case CLAY_ALIGN_X_LEFT: extraSpace = 0; break;
+            case CLAY_ALIGN_X_CENTER: extraSpace /= 2; break;
+            default: break;
+        }
+        parentNode.nextChildOffset.x += extraSpace;
+    } else {
+        for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+            contentSize.width = CLAY__MAX(contentSize.width, childElement->dimensions.width);
+            contentSize.height += childElement->dimensions.height;
+        }
+        contentSize.height += (float)(CLAY__MAX(currentElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        float extraSpace = currentElement->dimensions.height - (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) - contentSize.height;
+        switch (layoutConfig->childAlignment.y) {
+            case CLAY_ALIGN_Y_TOP: extraSpace = 0; break;
+            case CLAY_ALIGN_Y_CENTER: extraSpace /= 2; break;
+            default: break;
+        }
+        parentNode.nextChildOffset.y += extraSpace;
+    }
+
+    buffer->length += currentElement->childrenOrTextContent.children.length;
+    for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
+        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+        // Alignment along non layout axis
+        if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+            parentNode.nextChildOffset.y = currentElement->layoutConfig->padding.top;
+            float whiteSpaceAroundChild = currentElement->dimensions.height - (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) - childElement->dimensions.height;
+            switch (layoutConfig->childAlignment.y) {
+                case CLAY_ALIGN_Y_TOP: break;
+                case CLAY_ALIGN_Y_CENTER: parentNode.nextChildOffset.y += whiteSpaceAroundChild / 2; break;
+                case CLAY_ALIGN_Y_BOTTOM: parentNode.nextChildOffset.y += whiteSpaceAroundChild; break;
+            }
+        } else {
+            parentNode.nextChildOffset.x = currentElement->layoutConfig->padding.left;
+            float whiteSpaceAroundChild = currentElement->dimensions.width - (float)(layoutConfig->padding.left + layoutConfig->padding.right) - childElement->dimensions.width;
+            switch (layoutConfig->childAlignment.x) {
+                case CLAY_ALIGN_X_LEFT: break;
+                case CLAY_ALIGN_X_CENTER: parentNode.nextChildOffset.x += whiteSpaceAroundChild / 2; break;
+                case CLAY_ALIGN_X_RIGHT: parentNode.nextChildOffset.x += whiteSpaceAroundChild; break;
+            }
+        }
+
+        Clay_Vector2 childPosition = {
+            parentNode.position.x + parentNode.nextChildOffset.x + scrollOffset.x,
+            parentNode.position.y + parentNode.nextChildOffset.y + scrollOffset.y,
+        };
+
+        // Buffer elements need to be added in reverse because stack traversal happens backwards
+        buffer->internalArray[buffer->length - 1 - i] = CLAY__INIT(Clay__LayoutElementTreeNode) {
+            .layoutElement = childElement,
+            .position = { childPosition.x, childPosition.y },
+            .nextChildOffset = { .x = (float)childElement->layoutConfig->padding.left, .y = (float)childElement->layoutConfig->padding.top },
+        };
+
+        // Update parent offsets
+        if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+            parentNode.nextChildOffset.x += childElement->dimensions.width + (float)layoutConfig->childGap;
+        } else {
+            parentNode.nextChildOffset.y += childElement->dimensions.height + (float)layoutConfig->childGap;
+        }
+    }
+}
+
+Clay__SubtreeBounds Clay__BoundingBoxToSubtreeBounds(Clay_BoundingBox boundingBox) {
+    return CLAY__INIT(Clay__SubtreeBounds) { boundingBox.x, boundingBox.y, boundingBox.x + boundingBox.width, boundingBox.y + boundingBox.height };
+}
+
+// The pointer can only be over an element or anything below it while it's inside the element's subtree bounds: its bounding box,
+// grown to take in the subtree bounds of its children unless it's contained (see Clay__FinalizeLayoutElementSizes). This fills
+// them in once all of an element's children have been, starting from its own bounding box. It also flags the elements whose
+// children's subtree bounds follow on from one another along the layout direction without overlapping, so that hit testing can
+// binary search for the ones under the pointer.
+void Clay__CalculateSubtreeBounds(int32_t elementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, elementIndex);
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+        return;
+    }
+    Clay__SubtreeBounds *subtreeBounds = &context->layoutElementSubtreeBounds.internalArray[elementIndex];
+    bool contained = context->layoutElementSubtreeContained.internalArray[elementIndex];
+    bool horizontal = layoutElement->layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT;
+    bool ordered = true;
+    float previousChildEnd = -CLAY__MAXFLOAT;
+    for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; ++i) {
+        Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[layoutElement->childrenOrTextContent.children.elements[i]];
+        if (!contained) {
+            subtreeBounds->left = CLAY__MIN(subtreeBounds->left, childBounds.left);
+            subtreeBounds->top = CLAY__MIN(subtreeBounds->top, childBounds.top);
+            subtreeBounds->right = CLAY__MAX(subtreeBounds->right, childBounds.right);
+            subtreeBounds->bottom = CLAY__MAX(subtreeBounds->bottom, childBounds.bottom);
+        }
+        // Children with a negative size end before they start, which would leave their ends out of order
+        float childStart = horizontal ? childBounds.left : childBounds.top;
+        float childEnd = horizontal ? childBounds.right : childBounds.bottom;
+        ordered = ordered && childStart >= previousChildEnd && childEnd >= childStart;
+        previousChildEnd = childEnd;
+    }
+    context->layoutElementChildrenOrdered.internalArray[elementIndex] = ordered;
+}
+
+// Clay__CalculateFinalLayout doesn't descend into elements outside the visible rect when everything inside them is drawn
+// within their bounds, so the elements below them have no bounding box from that layout. This works them out the first
+// time one is asked for. It can only happen until the next Clay_BeginLayout, which starts replacing the layout elements.
+void Clay__PositionCulledLayoutElements(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementTreeNodeArray *dfsBuffer = &context->culledLayoutElements;
+    Clay__int32_tArray *positionedElementIndices = &context->culledLayoutElementIndices;
+    while (dfsBuffer->length > 0) {
+        // The culled element has been positioned already, start from its children
+        Clay__LayoutElementTreeNode culledNode = dfsBuffer->internalArray[--dfsBuffer->length];
+        int32_t subtreeStart = dfsBuffer->length;
+        positionedElementIndices->length = 0;
+        Clay__int32_tArray_Add(positionedElementIndices, (int32_t)(culledNode.layoutElement - context->layoutElements.internalArray));
+        Clay__AddChildTreeNodes(dfsBuffer, culledNode, Clay__GetScrollOffset(culledNode.layoutElement, CLAY__NULL));
+        while (dfsBuffer->length > subtreeStart) {
+            Clay__LayoutElementTreeNode currentNode = dfsBuffer->internalArray[--dfsBuffer->length];
+            Clay_LayoutElement *currentElement = currentNode.layoutElement;
+            Clay_BoundingBox currentElementBoundingBox = { currentNode.position.x, currentNode.position.y, currentElement->dimensions.width, currentElement->dimensions.height };
+            Clay_Vector2 scrollOffset = Clay__GetScrollOffset(currentElement, &currentElementBoundingBox);
+            Clay_LayoutElementHashMapItem *hashMapItem = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, (int32_t)(currentElement - context->layoutElements.internalArray))->hashMapItem;
+            if (!hashMapItem) {
+                hashMapItem = Clay__GetHashMapItem(currentElement->id);
+            }
+            hashMapItem->boundingBox = currentElementBoundingBox;
+            hashMapItem->boundingBoxGeneration = context->generation;
+            int32_t currentElementIndex = (int32_t)(currentElement - context->layoutElements.internalArray);
+            context->layoutElementSubtreeBounds.internalArray[currentElementIndex] = Clay__BoundingBoxToSubtreeBounds(currentElementBoundingBox);
+            Clay__int32_tArray_Add(positionedElementIndices, currentElementIndex);
+            if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+                Clay__AddChildTreeNodes(dfsBuffer, currentNode, scrollOffset);
+            }
+        }
+        // Elements were positioned parents first, so going backwards fills in subtree bounds from the bottom up
+        for (int32_t i = positionedElementIndices->length - 1; i >= 0; --i) {
+            Clay__CalculateSubtreeBounds(positionedElementIndices->internalArray[i]);
+        }
+    }
+}
+
+// Looks up an element, making sure its bounding box is up to date with the most recent layout
+Clay_LayoutElementHashMapItem *Clay__GetPositionedHashMapItem(Clay_ElementIdValue id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(id);
+    if (context->culledLayoutElements.length > 0 && hashMapItem->boundingBoxGeneration != context->generation) {
+        Clay__PositionCulledLayoutElements();
+    }
+    return hashMapItem;
+}
+
+// Runs once every element has its final size, visiting children before their parents. Remembers the sizes so that the next
+// frame can reuse them, works out the content size of scroll containers, and flags the elements that draw everything inside
+// them within their own bounding box, which lets Clay__CalculateFinalLayout skip past them when they aren't visible.
+void Clay__FinalizeLayoutElementSizes(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->layoutElementSubtreeContained.length = context->layoutElements.length;
+    for (int32_t elementIndex = context->layoutElements.length - 1; elementIndex >= 0; --elementIndex) {
+        Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, elementIndex);
+        // Elements with a duplicate ID aren't linked to a hash map item
+        Clay__LayoutElementFingerprint *fingerprint = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, elementIndex);
+        if (fingerprint->hashMapItem) {
+            fingerprint->hashMapItem->layoutFingerprint = fingerprint->reusable ? fingerprint->fingerprint : 0;
+            fingerprint->hashMapItem->layoutDimensions = layoutElement->dimensions;
+            fingerprint->hashMapItem->layoutGeneration = context->generation;
+        }
+        // Text lines are only rendered when the text element itself is visible
+        bool contained = true;
+        if (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+            Clay_Dimensions contentSize = {0,0};
+            for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; ++i) {
+                int32_t childIndex = layoutElement->childrenOrTextContent.children.elements[i];
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
+                if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+                    contentSize.width += childElement->dimensions.width;
+                    contentSize.height = CLAY__MAX(contentSize.height, childElement->dimensions.height);
+                } else {
+                    contentSize.width = CLAY__MAX(contentSize.width, childElement->dimensions.width);
+                    contentSize.height += childElement->dimensions.height;
+                }
+                contained = contained && context->layoutElementSubtreeContained.internalArray[childIndex];
+            }
+            if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+                contentSize.width += (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+            } else {
+                contentSize.height += (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+            }
+            contentSize = CLAY__INIT(Clay_Dimensions) { contentSize.width + (float)(layoutConfig->padding.left + layoutConfig->padding.right), contentSize.height + (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) };
+            if (layoutElement->childrenOrTextContent.children.length > 0) {
+                contained = contained && contentSize.width <= layoutElement->dimensions.width && contentSize.height <= layoutElement->dimensions.height;
+            }
+            if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+                Clay__ScrollContainerDataInternal *mapping = Clay__GetItemScrollContainerData(Clay__GetLayoutElementHashMapItem(elementIndex));
+                if (mapping && mapping->layoutElement == layoutElement) {
+                    mapping->contentSize = contentSize;
+                }
+                // Whatever overflows is clipped, unless the renderer is doing the scrolling and will move it into view
+                contained = contained || !context->externalScrollHandlingEnabled;
+            }
+        }
+        context->layoutElementSubtreeContained.internalArray[elementIndex] = contained;
+    }
+}
+
+void Clay__CacheWrappedTextLines(Clay__MeasureTextCacheItem *measureTextCacheItem, Clay__WrappedTextLineArraySlice wrappedLines, float containerWidth, float lineHeight) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (measureTextCacheItem == &Clay__MeasureTextCacheItem_DEFAULT) {
+        return;
+    }
+    if (context->wrappedTextLinesCache.length + wrappedLines.length > context->wrappedTextLinesCache.capacity) {
+        context->wrappedTextLinesCacheFull = true;
+        return;
+    }
+    measureTextCacheItem->wrappedContainerWidth = containerWidth;
+    measureTextCacheItem->wrappedLineHeight = lineHeight;
+    measureTextCacheItem->wrappedLinesStartIndex = context->wrappedTextLinesCache.length;
+    measureTextCacheItem->wrappedLinesLength = wrappedLines.length;
+    measureTextCacheItem->wrappedLinesEpoch = context->wrappedTextLinesCacheEpoch;
+    for (int32_t i = 0; i < wrappedLines.length; ++i) {
+        Clay__WrappedTextLineArray_Add(&context->wrappedTextLinesCache, wrappedLines.internalArray[i]);
+    }
 }
 
 void Clay__CalculateFinalLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
-    // Calculate sizing along the X axis
-    Clay__SizeContainersAlongAxis(true);
+    // When nothing that affects sizing has changed, every element takes the size it had last frame instead of going through the
+    // sizing passes. Text still goes through wrapping below to find its lines.
+    bool layoutUnchanged = Clay__LayoutTreesUnchanged();
+    if (layoutUnchanged) {
+        for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+            Clay_LayoutElementArray_Get(&context->layoutElements, i)->dimensions = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, i)->hashMapItem->layoutDimensions;
+        }
+    } else {
+        // Calculate sizing along the X axis
+        Clay__SizeContainersAlongAxis(true);
+    }
 
     // Wrap text
+    if (context->wrappedTextLinesCacheFull) {
+        // Only discard cached wrap results between frames, so that slices handed out earlier in the frame stay valid
+        context->wrappedTextLinesCache.length = 0;
+        context->wrappedTextLinesCacheEpoch++;
+        context->wrappedTextLinesCacheFull = false;
+    }
     for (int32_t textElementIndex = 0; textElementIndex < context->textElementData.length; ++textElementIndex) {
         Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&context->textElementData, textElementIndex);
         textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
         Clay_LayoutElement *containerElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)textElementData->elementIndex);
         Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(containerElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
-        Clay__MeasureTextCacheItem *measureTextCacheItem = Clay__MeasureTextCached(&textElementData->text, textConfig);
+        Clay__MeasureTextCacheItem *measureTextCacheItem = textElementData->measured;
         float lineWidth = 0;
         float lineHeight = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textElementData->preferredDimensions.height;
         int32_t lineLengthChars = 0;
         int32_t lineStartOffset = 0;
+        float lineY = 0;
+        // The same text wrapped at the same width and line height as last time can reuse the previous lines
+        if (measureTextCacheItem->wrappedLinesEpoch == context->wrappedTextLinesCacheEpoch && measureTextCacheItem->wrappedContainerWidth == containerElement->dimensions.width && measureTextCacheItem->wrappedLineHeight == lineHeight) {
+            textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = measureTextCacheItem->wrappedLinesLength, .internalArray = &context->wrappedTextLinesCache.internalArray[measureTextCacheItem->wrappedLinesStartIndex] };
+            containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
+            continue;
+        }
         if (!measureTextCacheItem->containsNewlines && textElementData->preferredDimensions.width <= containerElement->dimensions.width) {
-            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { containerElement->dimensions,  textElementData->text });
+            // Sized exactly as the cached lines above would size it, so a hit and a miss give the same height
+            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { containerElement->dimensions.width, lineHeight }, 0, textElementData->text.length, 0 });
             textElementData->wrappedLines.length++;
+            containerElement->dimensions.height = lineHeight;
+            Clay__CacheWrappedTextLines(measureTextCacheItem, textElementData->wrappedLines, containerElement->dimensions.width, lineHeight);
             continue;
         }
         int32_t wordIndex = measureTextCacheItem->measuredWordsStartIndex;
@@ -1828,7 +3240,8 @@ void Clay__CalculateFinalLayout(void) {
             Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
             // Only word on the line is too large, just render it anyway
             if (lineLengthChars == 0 && lineWidth + measuredWord->width > containerElement->dimensions.width) {
-                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { measuredWord->width, lineHeight }, { .length = measuredWord->length, .chars = &textElementData->text.chars[measuredWord->startOffset] } });
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { measuredWord->width, lineHeight }, measuredWord->startOffset, measuredWord->length, lineY });
+                lineY += lineHeight;
                 textElementData->wrappedLines.length++;
                 wordIndex = measuredWord->next;
                 lineStartOffset = measuredWord->startOffset + measuredWord->length;
@@ -1836,7 +3249,8 @@ void Clay__CalculateFinalLayout(void) {
             // measuredWord->length == 0 means a newline character
             else if (measuredWord->length == 0 || lineWidth + measuredWord->width > containerElement->dimensions.width) {
                 // Wrapped text lines list has overflowed, just render out the line
-                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, { .length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, lineStartOffset, lineLengthChars, lineY });
+                lineY += lineHeight;
                 textElementData->wrappedLines.length++;
                 if (lineLengthChars == 0 || measuredWord->length == 0) {
                     wordIndex = measuredWord->next;
@@ -1851,23 +3265,34 @@ void Clay__CalculateFinalLayout(void) {
             }
         }
         if (lineLengthChars > 0) {
-            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
+            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, lineStartOffset, lineLengthChars, lineY });
             textElementData->wrappedLines.length++;
         }
         containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
+        // If the wrapped lines list overflowed the result is incomplete, don't keep it around
+        if (context->wrappedTextLines.length < context->wrappedTextLines.capacity) {
+            Clay__CacheWrappedTextLines(measureTextCacheItem, textElementData->wrappedLines, containerElement->dimensions.width, lineHeight);
+        }
+    }
+    // Wrapping sets text to the height of its lines, put back the height it was given last frame in case its parent squashed it
+    if (layoutUnchanged) {
+        for (int32_t textElementIndex = 0; textElementIndex < context->textElementData.length; ++textElementIndex) {
+            int32_t elementIndex = Clay__TextElementDataArray_Get(&context->textElementData, textElementIndex)->elementIndex;
+            Clay_LayoutElementArray_Get(&context->layoutElements, elementIndex)->dimensions.height = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, elementIndex)->hashMapItem->layoutDimensions.height;
+        }
     }
 
-    // Scale vertical image heights according to aspect ratio
-    for (int32_t i = 0; i < context->imageElementPointers.length; ++i) {
+    // Scale vertical image heights according to aspect ratio, already done if the sizes were carried over
+    for (int32_t i = 0; i < context->imageElementPointers.length && !layoutUnchanged; ++i) {
         Clay_LayoutElement* imageElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->imageElementPointers, i));
         Clay_ImageElementConfig *config = Clay__FindElementConfigWithType(imageElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE).imageElementConfig;
         imageElement->dimensions.height = (config->sourceDimensions.height / CLAY__MAX(config->sourceDimensions.width, 1)) * imageElement->dimensions.width;
     }
 
-    // Propagate effect of text wrapping, image aspect scaling etc. on height of parents
+    // Propagate effect of text wrapping, image aspect scaling etc. on height of parents, unless the sizes were carried over
     Clay__LayoutElementTreeNodeArray dfsBuffer = context->layoutElementTreeNodeArray1;
     dfsBuffer.length = 0;
-    for (int32_t i = 0; i < context->layoutElementTreeRoots.length; ++i) {
+    for (int32_t i = 0; i < context->layoutElementTreeRoots.length && !layoutUnchanged; ++i) {
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i);
         context->treeNodeVisited.internalArray[dfsBuffer.length] = false;
         Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex) });
@@ -1913,31 +3338,27 @@ void Clay__CalculateFinalLayout(void) {
     }
 
     // Calculate sizing along the Y axis
-    Clay__SizeContainersAlongAxis(false);
-
-    // Sort tree roots by z-index
-    int32_t sortMax = context->layoutElementTreeRoots.length - 1;
-    while (sortMax > 0) { // todo dumb bubble sort
-        for (int32_t i = 0; i < sortMax; ++i) {
-            Clay__LayoutElementTreeRoot current = *Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i);
-            Clay__LayoutElementTreeRoot next = *Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i + 1);
-            if (next.zIndex < current.zIndex) {
-                Clay__LayoutElementTreeRootArray_Set(&context->layoutElementTreeRoots, i, next);
-                Clay__LayoutElementTreeRootArray_Set(&context->layoutElementTreeRoots, i + 1, current);
-            }
-        }
-        sortMax--;
+    if (!layoutUnchanged) {
+        Clay__SizeContainersAlongAxis(false);
     }
 
+    // Sort tree roots by z-index
+    Clay__SortTreeRootsByZIndex(&context->layoutElementTreeRoots, context->layoutElementTreeRootsSortBuffer.internalArray);
+
+    Clay__FinalizeLayoutElementSizes();
+
     // Calculate final positions and generate render commands
     context->renderCommands.length = 0;
+    context->culledLayoutElements.length = 0;
+    context->layoutElementSubtreeBounds.length = context->layoutElements.length;
+    context->layoutElementChildrenOrdered.length = context->layoutElements.length;
     dfsBuffer.length = 0;
     for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
         dfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
         Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
         Clay_Vector2 rootPosition = CLAY__DEFAULT_STRUCT;
-        Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetHashMapItem(root->parentId);
+        Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetPositionedHashMapItem(root->parentId);
         // Position root floating containers
         if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) && parentHashMapItem) {
             Clay_FloatingElementConfig *config = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig;
@@ -1993,25 +3414,25 @@ void Clay__CalculateFinalLayout(void) {
             targetAttachPosition.y += config->offset.y;
             rootPosition = targetAttachPosition;
         }
+        Clay_BoundingBox visibleRect = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
         if (root->clipElementId) {
-            Clay_LayoutElementHashMapItem *clipHashMapItem = Clay__GetHashMapItem(root->clipElementId);
+            Clay_LayoutElementHashMapItem *clipHashMapItem = Clay__GetPositionedHashMapItem(root->clipElementId);
             if (clipHashMapItem) {
                 // Floating elements that are attached to scrolling contents won't be correctly positioned if external scroll handling is enabled, fix here
                 if (context->externalScrollHandlingEnabled) {
                     Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(clipHashMapItem->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                        if (mapping->layoutElement == clipHashMapItem->layoutElement) {
-                            root->pointerOffset = mapping->scrollPosition;
-                            if (scrollConfig->horizontal) {
-                                rootPosition.x += mapping->scrollPosition.x;
-                            }
-                            if (scrollConfig->vertical) {
-                                rootPosition.y += mapping->scrollPosition.y;
-                            }
-                            break;
+                    Clay__ScrollContainerDataInternal *mapping = Clay__GetItemScrollContainerData(clipHashMapItem);
+                    if (mapping && mapping->layoutElement == clipHashMapItem->layoutElement) {
+                        root->pointerOffset = mapping->scrollPosition;
+                        if (scrollConfig->horizontal) {
+                            rootPosition.x += mapping->scrollPosition.x;
+                        }
+                        if (scrollConfig->vertical) {
+                            rootPosition.y += mapping->scrollPosition.y;
                         }
                     }
+                } else {
+                    visibleRect = Clay__IntersectBoundingBoxes(visibleRect, clipHashMapItem->boundingBox);
                 }
                 Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                     .boundingBox = clipHashMapItem->boundingBox,
@@ -2022,14 +3443,16 @@ void Clay__CalculateFinalLayout(void) {
                 });
             }
         }
+        context->visibleRectStack.length = 0;
+        Clay__BoundingBoxArray_Add(&context->visibleRectStack, visibleRect);
         Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->layoutConfig->padding.left, .y = (float)rootElement->layoutConfig->padding.top } });
 
         context->treeNodeVisited.internalArray[0] = false;
         while (dfsBuffer.length > 0) {
             Clay__LayoutElementTreeNode *currentElementTreeNode = Clay__LayoutElementTreeNodeArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1);
             Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
+            int32_t currentElementIndex = (int32_t)(currentElement - context->layoutElements.internalArray);
             Clay_LayoutConfig *layoutConfig = currentElement->layoutConfig;
-            Clay_Vector2 scrollOffset = CLAY__DEFAULT_STRUCT;
 
             // This will only be run a single time for each element in downwards DFS order
             if (!context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
@@ -2045,66 +3468,34 @@ void Clay__CalculateFinalLayout(void) {
                     currentElementBoundingBox.height += expand.height * 2;
                 }
 
-                Clay__ScrollContainerDataInternal *scrollContainerData = CLAY__NULL;
                 // Apply scroll offsets to container
-                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                    Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-
-                    // This linear scan could theoretically be slow under very strange conditions, but I can't imagine a real UI with more than a few 10's of scroll containers
-                    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                        if (mapping->layoutElement == currentElement) {
-                            scrollContainerData = mapping;
-                            mapping->boundingBox = currentElementBoundingBox;
-                            if (scrollConfig->horizontal) {
-                                scrollOffset.x = mapping->scrollPosition.x;
-                            }
-                            if (scrollConfig->vertical) {
-                                scrollOffset.y = mapping->scrollPosition.y;
-                            }
-                            if (context->externalScrollHandlingEnabled) {
-                                scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
-                            }
-                            break;
-                        }
-                    }
-                }
+                Clay_Vector2 scrollOffset = Clay__GetScrollOffset(currentElement, &currentElementBoundingBox);
 
-                Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(currentElement->id);
-                if (hashMapItem) {
-                    hashMapItem->boundingBox = currentElementBoundingBox;
+                // Culling - Don't bother to generate render commands for elements entirely outside the screen or the scroll containers they're in
+                Clay_BoundingBox *visibleRect = Clay__BoundingBoxArray_Get(&context->visibleRectStack, context->visibleRectStack.length - 1);
+                bool offscreen = Clay__ElementIsOutsideVisibleRect(&currentElementBoundingBox, visibleRect);
+                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+                    Clay__BoundingBoxArray_Add(&context->visibleRectStack, context->externalScrollHandlingEnabled ? *visibleRect : Clay__IntersectBoundingBoxes(*visibleRect, currentElementBoundingBox));
                 }
 
-                int32_t sortedConfigIndexes[20];
-                for (int32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
-                    sortedConfigIndexes[elementConfigIndex] = elementConfigIndex;
-                }
-                sortMax = currentElement->elementConfigs.length - 1;
-                while (sortMax > 0) { // todo dumb bubble sort
-                    for (int32_t i = 0; i < sortMax; ++i) {
-                        int32_t current = sortedConfigIndexes[i];
-                        int32_t next = sortedConfigIndexes[i + 1];
-                        Clay__ElementConfigType currentType = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, current)->type;
-                        Clay__ElementConfigType nextType = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, next)->type;
-                        if (nextType == CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER || currentType == CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER) {
-                            sortedConfigIndexes[i] = next;
-                            sortedConfigIndexes[i + 1] = current;
-                        }
-                    }
-                    sortMax--;
+                // Elements with a duplicate ID aren't linked to a hash map item, and fall back to looking it up
+                Clay_LayoutElementHashMapItem *hashMapItem = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, currentElementIndex)->hashMapItem;
+                if (!hashMapItem) {
+                    hashMapItem = Clay__GetHashMapItem(currentElement->id);
                 }
+                hashMapItem->boundingBox = currentElementBoundingBox;
+                hashMapItem->boundingBoxGeneration = context->generation;
+                context->layoutElementSubtreeBounds.internalArray[currentElementIndex] = Clay__BoundingBoxToSubtreeBounds(currentElementBoundingBox);
 
-                // Create the render commands for this element
+                // Create the render commands for this element, the configs are already in render order (see Clay__ElementPostConfiguration)
                 for (int32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
-                    Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, sortedConfigIndexes[elementConfigIndex]);
+                    Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, elementConfigIndex);
                     Clay_RenderCommand renderCommand = {
                         .boundingBox = currentElementBoundingBox,
                         .config = elementConfig->config,
                         .id = currentElement->id,
                     };
 
-                    bool offscreen = Clay__ElementIsOffscreen(&currentElementBoundingBox);
-                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
                     bool shouldRender = !offscreen;
                     switch (elementConfig->type) {
                         case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE: {
@@ -2139,24 +3530,38 @@ void Clay__CalculateFinalLayout(void) {
                             float naturalLineHeight = currentElement->childrenOrTextContent.textElementData->preferredDimensions.height;
                             float finalLineHeight = textElementConfig->lineHeight > 0 ? (float)textElementConfig->lineHeight : naturalLineHeight;
                             float lineHeightOffset = (finalLineHeight - naturalLineHeight) / 2;
-                            float yPosition = lineHeightOffset;
-                            for (int32_t lineIndex = 0; lineIndex < currentElement->childrenOrTextContent.textElementData->wrappedLines.length; ++lineIndex) {
-                                Clay__WrappedTextLine wrappedLine = currentElement->childrenOrTextContent.textElementData->wrappedLines.internalArray[lineIndex]; // todo range check
-                                if (wrappedLine.line.length == 0) {
-                                    yPosition += finalLineHeight;
+                            Clay__WrappedTextLineArraySlice wrappedLines = currentElement->childrenOrTextContent.textElementData->wrappedLines;
+                            // Binary search for the first line that reaches down into the visible rect, so that long text scrolled a
+                            // long way down doesn't walk all of the lines above it
+                            int32_t firstLineIndex = 0;
+                            if (!context->disableCulling) {
+                                float visibleTop = visibleRect->y - currentElementBoundingBox.y - lineHeightOffset - finalLineHeight;
+                                int32_t endLineIndex = wrappedLines.length;
+                                while (firstLineIndex < endLineIndex) {
+                                    int32_t middleLineIndex = firstLineIndex + (endLineIndex - firstLineIndex) / 2;
+                                    if (wrappedLines.internalArray[middleLineIndex].yOffset < visibleTop) {
+                                        firstLineIndex = middleLineIndex + 1;
+                                    } else {
+                                        endLineIndex = middleLineIndex;
+                                    }
+                                }
+                            }
+                            for (int32_t lineIndex = firstLineIndex; lineIndex < wrappedLines.length; ++lineIndex) {
+                                Clay__WrappedTextLine wrappedLine = wrappedLines.internalArray[lineIndex];
+                                float yPosition = lineHeightOffset + wrappedLine.yOffset;
+                                if (wrappedLine.length == 0) {
                                     continue;
                                 }
                                 Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                                     .boundingBox = { currentElementBoundingBox.x, currentElementBoundingBox.y + yPosition, wrappedLine.dimensions.width, wrappedLine.dimensions.height }, // TODO width
                                     .config = configUnion,
-                                    .text = CLAY__INIT(Clay_StringSlice) { .length = wrappedLine.line.length, .chars = wrappedLine.line.chars, .baseChars = currentElement->childrenOrTextContent.textElementData->text.chars },
+                                    .text = CLAY__INIT(Clay_StringSlice) { .length = wrappedLine.length, .chars = &currentElement->childrenOrTextContent.textElementData->text.chars[wrappedLine.startOffset], .baseChars = currentElement->childrenOrTextContent.textElementData->text.chars },
                                     .zIndex = root->zIndex,
                                     .id = Clay__HashNumber(lineIndex, currentElement->id).id,
                                     .commandType = CLAY_RENDER_COMMAND_TYPE_TEXT,
                                 });
-                                yPosition += finalLineHeight;
 
-                                if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > context->layoutDimensions.height)) {
+                                if (!context->disableCulling && (currentElementBoundingBox.y + yPosition + finalLineHeight > visibleRect->y + visibleRect->height)) {
                                     break;
                                 }
                             }
@@ -2171,76 +3576,43 @@ void Clay__CalculateFinalLayout(void) {
                     if (shouldRender) {
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (offscreen) {
-                        // NOTE: You may be tempted to try an early return / continue if an element is off screen. Why bother calculating layout for its children, right?
-                        // Unfortunately, a FLOATING_CONTAINER may be defined that attaches to a child or grandchild of this element, which is large enough to still
-                        // be on screen, even if this element isn't. That depends on this element and it's children being laid out correctly (even if they are entirely off screen)
-                    }
                 }
 
-                // Setup initial on-axis alignment
-                if (!Clay__ElementHasConfig(currentElementTreeNode->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
-                    Clay_Dimensions contentSize = {0,0};
-                    if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-                        for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
-                            contentSize.width += childElement->dimensions.width;
-                            contentSize.height = CLAY__MAX(contentSize.height, childElement->dimensions.height);
-                        }
-                        contentSize.width += (float)(CLAY__MAX(currentElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-                        float extraSpace = currentElement->dimensions.width - (float)(layoutConfig->padding.left + layoutConfig->padding.right) - contentSize.width;
-                        switch (layoutConfig->childAlignment.x) {
-                            case CLAY_ALIGN_X_LEFT: extraSpace = 0; break;
-                            case CLAY_ALIGN_X_CENTER: extraSpace /= 2; break;
-                            default: break;
-                        }
-                        currentElementTreeNode->nextChildOffset.x += extraSpace;
+                // Add children to the DFS buffer. If nothing inside this element can be seen they are left to Clay__PositionCulledLayoutElements,
+                // as a floating element might still be attached to one of them or it might be queried for its bounding box
+                if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && currentElement->childrenOrTextContent.children.length > 0) {
+                    if (offscreen && context->layoutElementSubtreeContained.internalArray[currentElementIndex]) {
+                        Clay__LayoutElementTreeNodeArray_Add(&context->culledLayoutElements, *currentElementTreeNode);
                     } else {
-                        for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
-                            contentSize.width = CLAY__MAX(contentSize.width, childElement->dimensions.width);
-                            contentSize.height += childElement->dimensions.height;
+                        int32_t firstChildNodeIndex = dfsBuffer.length;
+                        Clay__AddChildTreeNodes(&dfsBuffer, *currentElementTreeNode, scrollOffset);
+                        for (int32_t i = firstChildNodeIndex; i < dfsBuffer.length; ++i) {
+                            context->treeNodeVisited.internalArray[i] = false;
                         }
-                        contentSize.height += (float)(CLAY__MAX(currentElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-                        float extraSpace = currentElement->dimensions.height - (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) - contentSize.height;
-                        switch (layoutConfig->childAlignment.y) {
-                            case CLAY_ALIGN_Y_TOP: extraSpace = 0; break;
-                            case CLAY_ALIGN_Y_CENTER: extraSpace /= 2; break;
-                            default: break;
-                        }
-                        currentElementTreeNode->nextChildOffset.y += extraSpace;
-                    }
-
-                    if (scrollContainerData) {
-                        scrollContainerData->contentSize = CLAY__INIT(Clay_Dimensions) { contentSize.width + (float)(layoutConfig->padding.left + layoutConfig->padding.right), contentSize.height + (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) };
                     }
                 }
             }
             else {
-                // DFS is returning upwards backwards
-                bool closeScrollElement = false;
-                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                    closeScrollElement = true;
-                    Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                        if (mapping->layoutElement == currentElement) {
-                            if (scrollConfig->horizontal) { scrollOffset.x = mapping->scrollPosition.x; }
-                            if (scrollConfig->vertical) { scrollOffset.y = mapping->scrollPosition.y; }
-                            if (context->externalScrollHandlingEnabled) {
-                                scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
-                            }
-                            break;
-                        }
-                    }
+                // DFS is returning upwards backwards. Elements whose children were culled have their subtree bounds finished off
+                // when the children are positioned.
+                if (context->culledLayoutElements.length == 0 || context->culledLayoutElements.internalArray[context->culledLayoutElements.length - 1].layoutElement != currentElement) {
+                    Clay__CalculateSubtreeBounds(currentElementIndex);
+                }
+                bool closeScrollElement = Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER);
+                Clay_Vector2 scrollOffset = Clay__GetScrollOffset(currentElement, CLAY__NULL);
+                if (closeScrollElement) {
+                    context->visibleRectStack.length--;
                 }
 
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER)) {
-                    Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
+                    Clay_LayoutElementHashMapItem *currentElementData = Clay__LayoutElementFingerprintArray_Get(&context->layoutElementFingerprints, currentElementIndex)->hashMapItem;
+                    if (!currentElementData) {
+                        currentElementData = Clay__GetHashMapItem(currentElement->id);
+                    }
                     Clay_BoundingBox currentElementBoundingBox = currentElementData->boundingBox;
 
                     // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
-                    if (!Clay__ElementIsOffscreen(&currentElementBoundingBox)) {
+                    if (!Clay__ElementIsOutsideVisibleRect(&currentElementBoundingBox, Clay__BoundingBoxArray_Get(&context->visibleRectStack, context->visibleRectStack.length - 1))) {
                         Clay_BorderElementConfig *borderConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER).borderElementConfig;
                         Clay_RenderCommand renderCommand = {
                                 .boundingBox = currentElementBoundingBox,
@@ -2292,54 +3664,6 @@ void Clay__CalculateFinalLayout(void) {
                 }
 
                 dfsBuffer.length--;
-                continue;
-            }
-
-            // Add children to the DFS buffer
-            if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
-                dfsBuffer.length += currentElement->childrenOrTextContent.children.length;
-                for (int32_t i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
-                    // Alignment along non layout axis
-                    if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-                        currentElementTreeNode->nextChildOffset.y = currentElement->layoutConfig->padding.top;
-                        float whiteSpaceAroundChild = currentElement->dimensions.height - (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) - childElement->dimensions.height;
-                        switch (layoutConfig->childAlignment.y) {
-                            case CLAY_ALIGN_Y_TOP: break;
-                            case CLAY_ALIGN_Y_CENTER: currentElementTreeNode->nextChildOffset.y += whiteSpaceAroundChild / 2; break;
-                            case CLAY_ALIGN_Y_BOTTOM: currentElementTreeNode->nextChildOffset.y += whiteSpaceAroundChild; break;
-                        }
-                    } else {
-                        currentElementTreeNode->nextChildOffset.x = currentElement->layoutConfig->padding.left;
-                        float whiteSpaceAroundChild = currentElement->dimensions.width - (float)(layoutConfig->padding.left + layoutConfig->padding.right) - childElement->dimensions.width;
-                        switch (layoutConfig->childAlignment.x) {
-                            case CLAY_ALIGN_X_LEFT: break;
-                            case CLAY_ALIGN_X_CENTER: currentElementTreeNode->nextChildOffset.x += whiteSpaceAroundChild / 2; break;
-                            case CLAY_ALIGN_X_RIGHT: currentElementTreeNode->nextChildOffset.x += whiteSpaceAroundChild; break;
-                        }
-                    }
-
-                    Clay_Vector2 childPosition = {
-                        currentElementTreeNode->position.x + currentElementTreeNode->nextChildOffset.x + scrollOffset.x,
-                        currentElementTreeNode->position.y + currentElementTreeNode->nextChildOffset.y + scrollOffset.y,
-                    };
-
-                    // DFS buffer elements need to be added in reverse because stack traversal happens backwards
-                    uint32_t newNodeIndex = dfsBuffer.length - 1 - i;
-                    dfsBuffer.internalArray[newNodeIndex] = CLAY__INIT(Clay__LayoutElementTreeNode) {
-                        .layoutElement = childElement,
-                        .position = { childPosition.x, childPosition.y },
-                        .nextChildOffset = { .x = (float)childElement->layoutConfig->padding.left, .y = (float)childElement->layoutConfig->padding.top },
-                    };
-                    context->treeNodeVisited.internalArray[newNodeIndex] = false;
-
-                    // Update parent offsets
-                    if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-                        currentElementTreeNode->nextChildOffset.x += childElement->dimensions.width + (float)layoutConfig->childGap;
-                    } else {
-                        currentElementTreeNode->nextChildOffset.y += childElement->dimensions.height + (float)layoutConfig->childGap;
-                    }
-                }
             }
         }
 
@@ -2347,6 +3671,15 @@ void Clay__CalculateFinalLayout(void) {
             Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) { .id = Clay__RehashWithNumber(rootElement->id, 11), .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END });
         }
     }
+
+    // A floating element attached to something in a tree that's laid out after its own uses where that was in the previous frame,
+    // so make sure it was positioned this frame even if it was culled
+    for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        if (root->parentId) {
+            Clay__GetPositionedHashMapItem(root->parentId);
+        }
+    }
 }
 
 void Clay__AttachId(Clay_ElementId elementId) {
@@ -2428,7 +3761,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
     Clay__DebugView_ScrollViewItemLayoutConfig = CLAY__INIT(Clay_LayoutConfig) { .sizing = { .height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT) }, .childGap = 6, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }};
     Clay__RenderDebugLayoutData layoutData = CLAY__DEFAULT_STRUCT;
 
-    uint32_t highlightedElementId = 0;
+    Clay_ElementIdValue highlightedElementId = 0;
 
     for (int32_t rootIndex = 0; rootIndex < initialRootsLength; ++rootIndex) {
         dfsBuffer.length = 0;
@@ -2675,15 +4008,12 @@ void Clay__RenderDebugView(void) {
     Clay_ElementId scrollId = Clay__HashString(CLAY_STRING("Clay__DebugViewOuterScrollPane"), 0, 0);
     float scrollYOffset = 0;
     bool pointerInDebugView = context->pointerInfo.position.y < context->layoutDimensions.height - 300;
-    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-        if (scrollContainerData->elementId == scrollId.id) {
-            if (!context->externalScrollHandlingEnabled) {
-                scrollYOffset = scrollContainerData->scrollPosition.y;
-            } else {
-                pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - 300;
-            }
-            break;
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetItemScrollContainerData(Clay__GetHashMapItem(scrollId.id));
+    if (scrollContainerData) {
+        if (!context->externalScrollHandlingEnabled) {
+            scrollYOffset = scrollContainerData->scrollPosition.y;
+        } else {
+            pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - 300;
         }
     }
     int32_t highlightedRow = pointerInDebugView
@@ -2978,6 +4308,58 @@ void Clay__RenderDebugView(void) {
                         }
                     }
                 }
+                CLAY(CLAY_ID("Clay__DebugViewMeasureTextCacheHeader"), CLAY_LAYOUT({ .sizing = {.height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT)}, .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, CLAY__DEBUGVIEW_OUTER_PADDING}, .childGap = 8, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} })) {
+                    CLAY_TEXT(CLAY_STRING("Text Measurement Cache"), warningConfig);
+                }
+                CLAY(CLAY_ID("Clay__DebugViewMeasureTextCacheTopBorder"), CLAY_LAYOUT({ .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1)} }), CLAY_RECTANGLE({ .color = {200, 200, 200, 255} })) {}
+                Clay_MeasureTextCacheStatistics statistics = Clay_GetMeasureTextCacheStatistics();
+                uint64_t lookups = statistics.hits + statistics.misses;
+                CLAY(CLAY_ID("Clay__DebugViewMeasureTextCacheBody"), CLAY_LAYOUT({ .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, CLAY__DEBUGVIEW_OUTER_PADDING}, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+                    CLAY_TEXT(CLAY_STRING("Hit Rate"), infoTitleConfig);
+                    CLAY(CLAY_LAYOUT(CLAY__DEFAULT_STRUCT)) {
+                        CLAY_TEXT(Clay__IntToString(lookups > 0 ? (int32_t)(statistics.hits * 100 / lookups) : 0), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING("% of "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString((int32_t)CLAY__MIN(lookups, (uint64_t)INT32_MAX)), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(" lookups"), infoTextConfig);
+                    }
+                    CLAY_TEXT(CLAY_STRING("Misses / Evictions"), infoTitleConfig);
+                    CLAY(CLAY_LAYOUT(CLAY__DEFAULT_STRUCT)) {
+                        CLAY_TEXT(Clay__IntToString((int32_t)CLAY__MIN(statistics.misses, (uint64_t)INT32_MAX)), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(" / "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString((int32_t)CLAY__MIN(statistics.evictions, (uint64_t)INT32_MAX)), infoTextConfig);
+                    }
+                    CLAY_TEXT(CLAY_STRING("Words Measured"), infoTitleConfig);
+                    CLAY(CLAY_LAYOUT(CLAY__DEFAULT_STRUCT)) {
+                        CLAY_TEXT(Clay__IntToString((int32_t)CLAY__MIN(statistics.wordsMeasured, (uint64_t)INT32_MAX)), infoTextConfig);
+                        #ifndef CLAY_WASM
+                        if (Clay__QueryTime) {
+                            CLAY_TEXT(CLAY_STRING(" in "), infoTextConfig);
+                            CLAY_TEXT(Clay__IntToString((int32_t)(statistics.measureTextFunctionSeconds * 1000)), infoTextConfig);
+                            CLAY_TEXT(CLAY_STRING(" ms"), infoTextConfig);
+                        }
+                        #endif
+                    }
+                    CLAY_TEXT(CLAY_STRING("Entries (live / capacity, free list)"), infoTitleConfig);
+                    CLAY(CLAY_LAYOUT(CLAY__DEFAULT_STRUCT)) {
+                        CLAY_TEXT(Clay__IntToString(statistics.liveEntries), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(" / "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(statistics.entryCapacity), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(", "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(statistics.entryFreeListLength), infoTextConfig);
+                    }
+                    CLAY_TEXT(CLAY_STRING("Words (live / peak / capacity, free list)"), infoTitleConfig);
+                    CLAY(CLAY_LAYOUT(CLAY__DEFAULT_STRUCT)) {
+                        CLAY_TEXT(Clay__IntToString(statistics.liveWords), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(" / "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(statistics.wordsHighWaterMark), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(" / "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(statistics.wordCapacity), infoTextConfig);
+                        CLAY_TEXT(CLAY_STRING(", "), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(statistics.wordFreeListLength), infoTextConfig);
+                    }
+                    CLAY_TEXT(CLAY_STRING("Capacity Exceeded"), infoTitleConfig);
+                    CLAY_TEXT(Clay__IntToString((int32_t)statistics.capacityExceededCount), infoTextConfig);
+                }
             }
         }
     }
@@ -3094,12 +4476,35 @@ void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_Str
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__MeasureText = measureTextFunction;
     context->mesureTextUserData = userData;
+    context->layoutFingerprintEpoch++;
 }
-void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, uintptr_t userData), uintptr_t userData) {
+void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(Clay_ElementIdValue elementId, uintptr_t userData), uintptr_t userData) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__QueryScrollOffset = queryScrollOffsetFunction;
     context->queryScrollOffsetUserData = userData;
 }
+void Clay_SetQueryTimeFunction(double (*queryTimeFunction)(uintptr_t userData), uintptr_t userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__QueryTime = queryTimeFunction;
+    context->queryTimeUserData = userData;
+}
+// Once set, text that isn't in the measurement cache is collected while the layout is declared and measured in one batch
+// at Clay_EndLayout. parallelForFunction must call task(i, taskData) for every i in [0, taskCount), from any threads, and
+// only return once they have all finished. The measure text function will then be called from several threads at once.
+void Clay_SetMeasureTextParallelFunction(void (*parallelForFunction)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData), uintptr_t userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextParallel = parallelForFunction;
+    context->measureTextParallelUserData = userData;
+}
+
+// Once set, Clay_EndLayout splits the sizing of large layouts into subtrees that don't depend on each other and sizes them
+// through parallelForFunction, which has the same contract as above. No user callbacks are made from these tasks, and the
+// layout comes out exactly the same as without it.
+void Clay_SetLayoutParallelFunction(void (*parallelForFunction)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData), uintptr_t userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutParallel = parallelForFunction;
+    context->layoutParallelUserData = userData;
+}
 #endif
 
 CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
@@ -3107,6 +4512,37 @@ void Clay_SetLayoutDimensions(Clay_Dimensions dimensions) {
     Clay_GetCurrentContext()->layoutDimensions = dimensions;
 }
 
+Clay_PointerDataInteractionState Clay__AdvancePointerState(Clay_PointerDataInteractionState state, bool isPointerDown) {
+    if (isPointerDown) {
+        if (state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+            return CLAY_POINTER_DATA_PRESSED;
+        } else if (state != CLAY_POINTER_DATA_PRESSED) {
+            return CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
+        }
+    } else {
+        if (state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
+            return CLAY_POINTER_DATA_RELEASED;
+        } else if (state != CLAY_POINTER_DATA_RELEASED)  {
+            return CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
+        }
+    }
+    return state;
+}
+
+// Index of the lowest set bit, value mustn't be zero
+int32_t Clay__LowestSetBitIndex(uint64_t value) {
+    #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+    #else
+    int32_t index = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        index++;
+    }
+    return index;
+    #endif
+}
+
 CLAY_WASM_EXPORT("Clay_SetPointerState")
 void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -3115,42 +4551,88 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
     }
     context->pointerInfo.position = position;
     context->pointerOverIds.length = 0;
+    context->pointerOverGeneration++;
+    context->pointerOverIdBits = 0;
+    Clay_PointerEventArray previousPointerEventTargets = context->pointerEventTargets;
+    context->pointerEventTargets = context->pointerEventTargetsBuffer;
+    context->pointerEventTargets.length = 0;
+    context->pointerEventTargetsBuffer = previousPointerEventTargets;
     Clay__int32_tArray dfsBuffer = context->layoutElementChildrenBuffer;
     for (int32_t rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
         dfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
-        Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
-        context->treeNodeVisited.internalArray[0] = false;
+        Clay_Vector2 rootPosition = { position.x + root->pointerOffset.x, position.y + root->pointerOffset.y };
+        // Floating elements inside a scroll container are clipped by it like the rest of its contents
+        if (root->clipElementId == 0 || context->externalScrollHandlingEnabled || Clay__PointIsInsideRect(rootPosition, Clay__GetPositionedHashMapItem(root->clipElementId)->boundingBox)) {
+            Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
+        }
         bool found = false;
+        // Depth first so that pointerOverIds is in the order elements were declared, skipping any subtree the pointer is outside of
         while (dfsBuffer.length > 0) {
-            if (context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
-                dfsBuffer.length--;
+            int32_t currentElementIndex = Clay__int32_tArray_GetValue(&dfsBuffer, (int)dfsBuffer.length - 1);
+            dfsBuffer.length--;
+            Clay__SubtreeBounds subtreeBounds = context->layoutElementSubtreeBounds.internalArray[currentElementIndex];
+            if (rootPosition.x < subtreeBounds.left || rootPosition.x > subtreeBounds.right || rootPosition.y < subtreeBounds.top || rootPosition.y > subtreeBounds.bottom) {
                 continue;
             }
-            context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
-            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&dfsBuffer, (int)dfsBuffer.length - 1));
-            Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapItem(currentElement->id); // TODO think of a way around this, maybe the fact that it's essentially a binary tree limits the cost, but the worst case is not great
-            Clay_BoundingBox elementBox = mapItem->boundingBox;
-            elementBox.x -= root->pointerOffset.x;
-            elementBox.y -= root->pointerOffset.y;
-            if (mapItem) {
-                if ((Clay__PointIsInsideRect(position, elementBox))) {
-                    if (mapItem->onHoverFunction) {
-                        mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
+            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElementIndex);
+            Clay_LayoutElementHashMapItem *mapItem = Clay__GetLayoutElementHashMapItem(currentElementIndex);
+            if (Clay__PointIsInsideRect(rootPosition, mapItem->boundingBox)) {
+                if (mapItem->onHoverFunction) {
+                    mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
+                }
+                Clay__ElementIdArray_Add(&context->pointerOverIds, mapItem->elementId);
+                context->pointerOverIdBits |= (uint64_t)1 << (mapItem->elementId.id & 63);
+                if (mapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+                    mapItem->pointerOverGeneration = context->pointerOverGeneration;
+                    // Elements sharing a duplicate id share an item too, and are only targeted once
+                    if (mapItem->pointerEventGeneration == mapItem->generation && mapItem->pointerEventTargetGeneration != context->pointerOverGeneration) {
+                        // Stamps start at 0, which the first call mustn't mistake for one from the call before
+                        bool entered = context->pointerOverGeneration == 1 || mapItem->pointerEventTargetGeneration != context->pointerOverGeneration - 1;
+                        mapItem->pointerEventTargetGeneration = context->pointerOverGeneration;
+                        Clay_PointerEventArray_Add(&context->pointerEventTargets, CLAY__INIT(Clay_PointerEvent) { mapItem->elementId, position, mapItem->pointerEventUserData, entered ? CLAY_POINTER_EVENT_ENTER : CLAY_POINTER_EVENT_PRESS });
                     }
-                    Clay__ElementIdArray_Add(&context->pointerOverIds, mapItem->elementId);
-                    found = true;
                 }
-                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
-                    dfsBuffer.length--;
-                    continue;
+                found = true;
+            }
+            Clay__LayoutElementChildren children = currentElement->childrenOrTextContent.children;
+            if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || children.length == 0) {
+                continue;
+            }
+            // Children that were culled have no bounds yet, but the pointer being inside this element means it might be over them
+            if (context->culledLayoutElements.length > 0) {
+                Clay_LayoutElement *firstChild = Clay_LayoutElementArray_Get(&context->layoutElements, children.elements[0]);
+                if (Clay__GetHashMapItem(firstChild->id)->boundingBoxGeneration != context->generation) {
+                    Clay__PositionCulledLayoutElements();
                 }
-                for (int32_t i = currentElement->childrenOrTextContent.children.length - 1; i >= 0; --i) {
-                    Clay__int32_tArray_Add(&dfsBuffer, currentElement->childrenOrTextContent.children.elements[i]);
-                    context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
+            }
+            int32_t firstChildIndex = 0;
+            int32_t endChildIndex = children.length;
+            if (context->layoutElementChildrenOrdered.internalArray[currentElementIndex]) {
+                // Only the children the pointer falls across along the layout direction can be under it. Usually that's one, but
+                // it can be two where they share an edge, or more with zero size.
+                bool horizontal = currentElement->layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT;
+                float pointerPosition = horizontal ? rootPosition.x : rootPosition.y;
+                while (firstChildIndex < endChildIndex) {
+                    int32_t middleChildIndex = firstChildIndex + (endChildIndex - firstChildIndex) / 2;
+                    Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[children.elements[middleChildIndex]];
+                    if ((horizontal ? childBounds.right : childBounds.bottom) < pointerPosition) {
+                        firstChildIndex = middleChildIndex + 1;
+                    } else {
+                        endChildIndex = middleChildIndex;
+                    }
                 }
-            } else {
-                dfsBuffer.length--;
+                endChildIndex = firstChildIndex;
+                while (endChildIndex < children.length) {
+                    Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[children.elements[endChildIndex]];
+                    if ((horizontal ? childBounds.left : childBounds.top) > pointerPosition) {
+                        break;
+                    }
+                    endChildIndex++;
+                }
+            }
+            for (int32_t i = endChildIndex - 1; i >= firstChildIndex; --i) {
+                Clay__int32_tArray_Add(&dfsBuffer, children.elements[i]);
             }
         }
 
@@ -3161,21 +4643,293 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
         }
     }
 
-    if (isPointerDown) {
-        if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED;
-        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_PRESSED) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
+    // Leaves are queued ahead of enters, so that handlers tracking a single hovered element see the old one go first
+    for (int32_t i = 0; i < previousPointerEventTargets.length; ++i) {
+        Clay_PointerEvent target = previousPointerEventTargets.internalArray[i];
+        if (Clay__GetHashMapItem(target.elementId.id)->pointerEventTargetGeneration != context->pointerOverGeneration) {
+            target.position = position;
+            target.type = CLAY_POINTER_EVENT_LEAVE;
+            Clay_PointerEventArray_Add(&context->pointerEvents, target);
         }
-    } else {
-        if (context->pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED;
-        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_RELEASED)  {
-            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
+    }
+    for (int32_t i = 0; i < context->pointerEventTargets.length; ++i) {
+        if (context->pointerEventTargets.internalArray[i].type == CLAY_POINTER_EVENT_ENTER) {
+            Clay_PointerEventArray_Add(&context->pointerEvents, context->pointerEventTargets.internalArray[i]);
+        }
+    }
+
+    context->pointerInfo.state = Clay__AdvancePointerState(context->pointerInfo.state, isPointerDown);
+    if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME || context->pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
+        for (int32_t i = 0; i < context->pointerEventTargets.length; ++i) {
+            Clay_PointerEvent event = context->pointerEventTargets.internalArray[i];
+            event.type = context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME ? CLAY_POINTER_EVENT_PRESS : CLAY_POINTER_EVENT_RELEASE;
+            Clay_PointerEventArray_Add(&context->pointerEvents, event);
         }
     }
 }
 
+// Spreads the low 16 bits of value out over the even bits
+uint32_t Clay__SpreadBits(uint32_t value) {
+    value &= 0xFFFF;
+    value = (value | (value << 8)) & 0x00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+void Clay__AdvancePointerBatchStates(Clay_PointerBatchItem *pointers, int32_t pointerCount) {
+    for (int32_t i = 0; i < pointerCount; ++i) {
+        pointers[i].state = Clay__AdvancePointerState(pointers[i].state, pointers[i].pointerDown);
+    }
+}
+
+// Orders the pointers along a Z shaped curve over the layout into pointerBatchOrder, so that pointers near each other on
+// screen end up near each other in the order
+void Clay__SortPointerBatch(Clay_PointerBatchItem *pointers, int32_t pointerCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__PointerBatchOrderArray *order = &context->pointerBatchOrder;
+    Clay__PointerBatchOrderArray *buffer = &context->pointerBatchOrderBuffer;
+    float scaleX = 65535 / CLAY__MAX(context->layoutDimensions.width, 1);
+    float scaleY = 65535 / CLAY__MAX(context->layoutDimensions.height, 1);
+    for (int32_t i = 0; i < pointerCount; ++i) {
+        uint32_t x = (uint32_t)CLAY__MIN(CLAY__MAX(pointers[i].position.x * scaleX, 0), 65535);
+        uint32_t y = (uint32_t)CLAY__MIN(CLAY__MAX(pointers[i].position.y * scaleY, 0), 65535);
+        order->internalArray[i] = CLAY__INIT(Clay__PointerBatchOrder) { i, Clay__SpreadBits(x) | (Clay__SpreadBits(y) << 1) };
+    }
+    order->length = pointerCount;
+    buffer->length = pointerCount;
+    if (pointerCount <= 64) {
+        return; // They all go in one pass anyway
+    }
+    // A byte at a time from the lowest, each pass keeps the order of the one before where keys tie
+    for (int32_t shift = 0; shift < 32; shift += 8) {
+        int32_t offsets[257] = { 0 };
+        for (int32_t i = 0; i < pointerCount; ++i) {
+            offsets[((order->internalArray[i].sortKey >> shift) & 0xFF) + 1]++;
+        }
+        for (int32_t digit = 0; digit < 256; ++digit) {
+            offsets[digit + 1] += offsets[digit];
+        }
+        for (int32_t i = 0; i < pointerCount; ++i) {
+            buffer->internalArray[offsets[(order->internalArray[i].sortKey >> shift) & 0xFF]++] = order->internalArray[i];
+        }
+        Clay__PointerBatchOrderArray swap = *order;
+        *order = *buffer;
+        *buffer = swap;
+    }
+}
+
+// Hit tests every pointer and advances each one's state like Clay_SetPointerState does for its single pointer. Pointers
+// are sorted so that nearby ones are tested together, up to 64 in each pass over the tree, sharing its work wherever their
+// paths down the tree are the same. Doesn't touch the single pointer, so Clay_Hovered, Clay_PointerOver and the scroll
+// containers aren't affected.
+// The ids a pointer is over are written to pointerOverIds next to each other, in the order Clay_SetPointerState would
+// find them. Returns how many ids were found. If that's more than pointerOverIdsCapacity the rest were left out and no
+// pointer's state was advanced, so calling again with the same pointers and more room gives the whole result.
+CLAY_WASM_EXPORT("Clay_SetPointerStates")
+int32_t Clay_SetPointerStates(Clay_PointerBatchItem *pointers, int32_t pointerCount, Clay_ElementId *pointerOverIds, int32_t pointerOverIdsCapacity) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t i = 0; i < pointerCount; ++i) {
+        pointers[i].pointerOverIdsOffset = 0;
+        pointers[i].pointerOverIdsLength = 0;
+    }
+    if (context->booleanWarnings.maxElementsExceeded) {
+        Clay__AdvancePointerBatchStates(pointers, pointerCount);
+        return 0;
+    }
+    int32_t pointerOverIdCount = 0;
+    Clay__PointerBatchTaskArray tasks = context->pointerBatchTasks;
+    Clay__PointerBatchTaskArray hits = context->pointerBatchHits;
+    int32_t windowCapacity = context->pointerBatchOrder.capacity;
+    for (int32_t windowStart = 0; windowStart < pointerCount; windowStart += windowCapacity) {
+        int32_t windowCount = CLAY__MIN(pointerCount - windowStart, windowCapacity);
+        Clay__SortPointerBatch(&pointers[windowStart], windowCount);
+        for (int32_t batchStart = 0; batchStart < windowCount; batchStart += 64) {
+            Clay_PointerBatchItem *batch[64];
+            int32_t batchCount = CLAY__MIN(windowCount - batchStart, 64);
+            for (int32_t i = 0; i < batchCount; ++i) {
+                batch[i] = &pointers[windowStart + context->pointerBatchOrder.internalArray[batchStart + i].pointerIndex];
+            }
+            // Copied out so that the traversal doesn't have to chase them around the pointers array
+            float positionsX[64];
+            float positionsY[64];
+            for (int32_t i = 0; i < batchCount; ++i) {
+                positionsX[i] = batch[i]->position.x;
+                positionsY[i] = batch[i]->position.y;
+            }
+            uint64_t uncapturedMask = batchCount == 64 ? ~(uint64_t)0 : ((uint64_t)1 << batchCount) - 1;
+            hits.length = 0;
+            for (int32_t rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0 && uncapturedMask != 0; --rootIndex) {
+                Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+                Clay_Vector2 offset = root->pointerOffset;
+                uint64_t rootMask = uncapturedMask;
+                if (root->clipElementId != 0 && !context->externalScrollHandlingEnabled) {
+                    Clay_BoundingBox clipBox = Clay__GetPositionedHashMapItem(root->clipElementId)->boundingBox;
+                    for (uint64_t bits = uncapturedMask; bits != 0; bits &= bits - 1) {
+                        int32_t pointerIndex = Clay__LowestSetBitIndex(bits);
+                        Clay_Vector2 position = { positionsX[pointerIndex] + offset.x, positionsY[pointerIndex] + offset.y };
+                        if (!Clay__PointIsInsideRect(position, clipBox)) {
+                            rootMask &= ~((uint64_t)1 << pointerIndex);
+                        }
+                    }
+                }
+                int32_t rootHitsStart = hits.length;
+                tasks.length = 0;
+                if (rootMask != 0) {
+                    Clay__PointerBatchTaskArray_Add(&tasks, CLAY__INIT(Clay__PointerBatchTask) { (int32_t)root->layoutElementIndex, rootMask });
+                }
+                while (tasks.length > 0) {
+                    Clay__PointerBatchTask task = Clay__PointerBatchTaskArray_GetValue(&tasks, (int)tasks.length - 1);
+                    tasks.length--;
+                    Clay__SubtreeBounds subtreeBounds = context->layoutElementSubtreeBounds.internalArray[task.layoutElementIndex];
+                    Clay_LayoutElementHashMapItem *mapItem = CLAY__NULL;
+                    uint64_t pointerMask = 0;
+                    uint64_t hitMask = 0;
+                    for (uint64_t bits = task.pointerMask; bits != 0; bits &= bits - 1) {
+                        int32_t pointerIndex = Clay__LowestSetBitIndex(bits);
+                        Clay_Vector2 position = { positionsX[pointerIndex] + offset.x, positionsY[pointerIndex] + offset.y };
+                        if (position.x < subtreeBounds.left || position.x > subtreeBounds.right || position.y < subtreeBounds.top || position.y > subtreeBounds.bottom) {
+                            continue;
+                        }
+                        pointerMask |= (uint64_t)1 << pointerIndex;
+                        if (!mapItem) {
+                            mapItem = Clay__GetLayoutElementHashMapItem(task.layoutElementIndex);
+                        }
+                        if (Clay__PointIsInsideRect(position, mapItem->boundingBox)) {
+                            hitMask |= (uint64_t)1 << pointerIndex;
+                        }
+                    }
+                    if (pointerMask == 0) {
+                        continue;
+                    }
+                    if (hitMask != 0) {
+                        Clay__PointerBatchTaskArray_Add(&hits, CLAY__INIT(Clay__PointerBatchTask) { task.layoutElementIndex, hitMask });
+                    }
+                    Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, task.layoutElementIndex);
+                    Clay__LayoutElementChildren children = currentElement->childrenOrTextContent.children;
+                    if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || children.length == 0) {
+                        continue;
+                    }
+                    if (context->culledLayoutElements.length > 0) {
+                        Clay_LayoutElement *firstChild = Clay_LayoutElementArray_Get(&context->layoutElements, children.elements[0]);
+                        if (Clay__GetHashMapItem(firstChild->id)->boundingBoxGeneration != context->generation) {
+                            Clay__PositionCulledLayoutElements();
+                        }
+                    }
+                    if (children.length == 1 || !context->layoutElementChildrenOrdered.internalArray[task.layoutElementIndex]) {
+                        for (int32_t i = children.length - 1; i >= 0; --i) {
+                            Clay__PointerBatchTaskArray_Add(&tasks, CLAY__INIT(Clay__PointerBatchTask) { children.elements[i], pointerMask });
+                        }
+                        continue;
+                    }
+                    // Taken in order along the layout direction, the range of children each pointer falls across only moves forwards.
+                    // That lets each search start from the last one, and pointers sharing a child share its task.
+                    bool horizontal = currentElement->layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT;
+                    float *positions = horizontal ? positionsX : positionsY;
+                    int32_t pointersInOrder[64];
+                    int32_t pointersInOrderCount = 0;
+                    for (uint64_t bits = pointerMask; bits != 0; bits &= bits - 1) {
+                        int32_t pointerIndex = Clay__LowestSetBitIndex(bits);
+                        int32_t insertIndex = pointersInOrderCount++;
+                        while (insertIndex > 0 && positions[pointersInOrder[insertIndex - 1]] > positions[pointerIndex]) {
+                            pointersInOrder[insertIndex] = pointersInOrder[insertIndex - 1];
+                            insertIndex--;
+                        }
+                        pointersInOrder[insertIndex] = pointerIndex;
+                    }
+                    int32_t firstChildTask = tasks.length;
+                    int32_t firstChildIndex = 0;
+                    for (int32_t i = 0; i < pointersInOrderCount; ++i) {
+                        int32_t pointerIndex = pointersInOrder[i];
+                        float pointerPosition = positions[pointerIndex] + (horizontal ? offset.x : offset.y);
+                        int32_t endChildIndex = firstChildIndex;
+                        for (int32_t step = 1; endChildIndex < children.length; step *= 2) {
+                            Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[children.elements[endChildIndex]];
+                            if ((horizontal ? childBounds.right : childBounds.bottom) >= pointerPosition) {
+                                break;
+                            }
+                            firstChildIndex = endChildIndex + 1;
+                            endChildIndex += step;
+                        }
+                        endChildIndex = CLAY__MIN(endChildIndex, children.length);
+                        while (firstChildIndex < endChildIndex) {
+                            int32_t middleChildIndex = firstChildIndex + (endChildIndex - firstChildIndex) / 2;
+                            Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[children.elements[middleChildIndex]];
+                            if ((horizontal ? childBounds.right : childBounds.bottom) < pointerPosition) {
+                                firstChildIndex = middleChildIndex + 1;
+                            } else {
+                                endChildIndex = middleChildIndex;
+                            }
+                        }
+                        endChildIndex = firstChildIndex;
+                        while (endChildIndex < children.length) {
+                            Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[children.elements[endChildIndex]];
+                            if ((horizontal ? childBounds.left : childBounds.top) > pointerPosition) {
+                                break;
+                            }
+                            endChildIndex++;
+                        }
+                        // Children from the first one onwards that already have a task are all at the end, one after another
+                        int32_t taskIndex = tasks.length;
+                        while (taskIndex > firstChildTask && firstChildIndex < endChildIndex && tasks.internalArray[taskIndex - 1].layoutElementIndex >= children.elements[firstChildIndex]) {
+                            taskIndex--;
+                        }
+                        for (int32_t childIndex = firstChildIndex; childIndex < endChildIndex; ++childIndex, ++taskIndex) {
+                            if (taskIndex < tasks.length) {
+                                tasks.internalArray[taskIndex].pointerMask |= (uint64_t)1 << pointerIndex;
+                            } else {
+                                Clay__PointerBatchTaskArray_Add(&tasks, CLAY__INIT(Clay__PointerBatchTask) { children.elements[childIndex], (uint64_t)1 << pointerIndex });
+                            }
+                        }
+                    }
+                    // Reversed so that the first child is taken off the stack first
+                    for (int32_t i = firstChildTask, j = tasks.length - 1; i < j; ++i, --j) {
+                        Clay__PointerBatchTask swap = tasks.internalArray[i];
+                        tasks.internalArray[i] = tasks.internalArray[j];
+                        tasks.internalArray[j] = swap;
+                    }
+                }
+
+                Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, root->layoutElementIndex);
+                if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) &&
+                        Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig->pointerCaptureMode == CLAY_POINTER_CAPTURE_MODE_CAPTURE) {
+                    for (int32_t i = rootHitsStart; i < hits.length; ++i) {
+                        uncapturedMask &= ~hits.internalArray[i].pointerMask;
+                    }
+                }
+            }
+
+            // Counted first so that each pointer's ids can be written next to each other
+            for (int32_t i = 0; i < hits.length; ++i) {
+                for (uint64_t bits = hits.internalArray[i].pointerMask; bits != 0; bits &= bits - 1) {
+                    batch[Clay__LowestSetBitIndex(bits)]->pointerOverIdsLength++;
+                }
+            }
+            for (int32_t i = 0; i < batchCount; ++i) {
+                batch[i]->pointerOverIdsOffset = pointerOverIdCount;
+                pointerOverIdCount += batch[i]->pointerOverIdsLength;
+                batch[i]->pointerOverIdsLength = 0;
+            }
+            for (int32_t i = 0; i < hits.length; ++i) {
+                Clay_ElementId elementId = Clay__GetLayoutElementHashMapItem(hits.internalArray[i].layoutElementIndex)->elementId;
+                for (uint64_t bits = hits.internalArray[i].pointerMask; bits != 0; bits &= bits - 1) {
+                    Clay_PointerBatchItem *pointer = batch[Clay__LowestSetBitIndex(bits)];
+                    int32_t idIndex = pointer->pointerOverIdsOffset + pointer->pointerOverIdsLength;
+                    if (idIndex < pointerOverIdsCapacity) {
+                        pointerOverIds[idIndex] = elementId;
+                        pointer->pointerOverIdsLength++;
+                    }
+                }
+            }
+        }
+    }
+    if (pointerOverIdCount <= pointerOverIdsCapacity) {
+        Clay__AdvancePointerBatchStates(pointers, pointerCount);
+    }
+    return pointerOverIdCount;
+}
+
 CLAY_WASM_EXPORT("Clay_Initialize")
 Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler) {
     Clay_Context *context = Clay__Context_Allocate_Arena(&arena);
@@ -3193,7 +4947,7 @@ Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions
     Clay__InitializePersistentMemory(context);
     Clay__InitializeEphemeralMemory(context);
     for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
-        context->layoutElementsHashMap.internalArray[i] = -1;
+        context->layoutElementsHashMap.internalArray[i] = CLAY__INIT(Clay__LayoutElementHashMapSlot) CLAY__DEFAULT_STRUCT;
     }
     for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
         context->measureTextHashMap.internalArray[i] = 0;
@@ -3213,6 +4967,70 @@ void Clay_SetCurrentContext(Clay_Context* context) {
     Clay__currentContext = context;
 }
 
+// Momentum is a speed in pixels per second that decays exponentially with time. The rate and the speed it stops at are the
+// same as taking 5% off a frame and stopping under 0.1 pixels a frame, at 60 frames a second.
+#define CLAY__SCROLL_MOMENTUM_DECAY_RATE 3.0775977f // -60 * ln(0.95)
+#define CLAY__SCROLL_MOMENTUM_STOP_SPEED 6.0f
+
+// e to the power of x. The integer part of x / ln(2) goes straight into the float's exponent, and a short series covers
+// what's left, which is within half of ln(2) of zero.
+float Clay__Exp(float x) {
+    if (x < -80) {
+        return 0;
+    }
+    x = CLAY__MIN(x, 80);
+    int32_t exponent = (int32_t)(x * 1.44269504f + (x < 0 ? -0.5f : 0.5f));
+    float r = x - (float)exponent * 0.693147181f;
+    float result = 1 + r * (1 + r * (1.0f / 2 + r * (1.0f / 6 + r * (1.0f / 24 + r * (1.0f / 120 + r * (1.0f / 720))))));
+    union { float asFloat; uint32_t asBits; } scale;
+    scale.asBits = (uint32_t)(exponent + 127) << 23;
+    return result * scale.asFloat;
+}
+
+// Natural log of a positive, normal x. The exponent comes from the float's bits, and the mantissa is brought within a factor
+// of the square root of two of one, where ln(m) = 2 atanh((m - 1) / (m + 1)) converges in a few terms.
+float Clay__Log(float x) {
+    union { float asFloat; uint32_t asBits; } value;
+    value.asFloat = x;
+    int32_t exponent = (int32_t)((value.asBits >> 23) & 255) - 127;
+    value.asBits = (value.asBits & 0x007FFFFF) | 0x3F800000;
+    float mantissa = value.asFloat;
+    if (mantissa > 1.41421356f) {
+        mantissa *= 0.5f;
+        exponent++;
+    }
+    float s = (mantissa - 1) / (mantissa + 1);
+    float s2 = s * s;
+    return 2 * s * (1 + s2 * (1.0f / 3 + s2 * (1.0f / 5 + s2 * (1.0f / 7)))) + (float)exponent * 0.693147181f;
+}
+
+// Decays one axis of momentum over deltaTime seconds and returns how far it moved the scroll position. Both have a closed
+// form, so one long step lands in the same place as many short ones.
+float Clay__ApplyScrollMomentum(float *momentum, float deltaTime) {
+    float speed = *momentum < 0 ? -*momentum : *momentum;
+    if (speed <= CLAY__SCROLL_MOMENTUM_STOP_SPEED || deltaTime <= 0) {
+        if (speed <= CLAY__SCROLL_MOMENTUM_STOP_SPEED) {
+            *momentum = 0;
+        }
+        return 0;
+    }
+    float stopTime = Clay__Log(speed / CLAY__SCROLL_MOMENTUM_STOP_SPEED) / CLAY__SCROLL_MOMENTUM_DECAY_RATE;
+    float decay = Clay__Exp(-CLAY__SCROLL_MOMENTUM_DECAY_RATE * CLAY__MIN(deltaTime, stopTime));
+    float distance = *momentum * (1 - decay) / CLAY__SCROLL_MOMENTUM_DECAY_RATE;
+    *momentum = deltaTime >= stopTime ? 0 : *momentum * decay;
+    return distance;
+}
+
+// Seconds until one axis of momentum has moved the scroll position by a whole pixel, or -1 if it stops before then. From
+// speed v it covers (v - stop speed) / decay rate before it stops.
+float Clay__ScrollMomentumPixelTime(float momentum) {
+    float speed = momentum < 0 ? -momentum : momentum;
+    if (speed - CLAY__SCROLL_MOMENTUM_STOP_SPEED <= CLAY__SCROLL_MOMENTUM_DECAY_RATE) {
+        return -1;
+    }
+    return -Clay__Log(1 - CLAY__SCROLL_MOMENTUM_DECAY_RATE / speed) / CLAY__SCROLL_MOMENTUM_DECAY_RATE;
+}
+
 CLAY_WASM_EXPORT("Clay_UpdateScrollContainers")
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -3222,27 +5040,25 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
     Clay__ScrollContainerDataInternal *highestPriorityScrollData = CLAY__NULL;
     for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
         Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        // Element isn't rendered this frame but scroll offset has been retained. The last entry is moved into its place, and
+        // is looked at next.
         if (!scrollData->openThisFrame) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
+            Clay__RemoveScrollContainerData(i);
+            i--;
             continue;
         }
         scrollData->openThisFrame = false;
-        Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(scrollData->elementId);
-        // Element isn't rendered this frame but scroll offset has been retained
-        if (!hashMapItem) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
-            continue;
-        }
 
         // Touch / click is released
         if (!isPointerActive && scrollData->pointerScrollActive) {
             float xDiff = scrollData->scrollPosition.x - scrollData->scrollOrigin.x;
+            // Flings start at the same number of pixels a frame as they always have, at 60 frames a second
             if (xDiff < -10 || xDiff > 10) {
-                scrollData->scrollMomentum.x = (scrollData->scrollPosition.x - scrollData->scrollOrigin.x) / (scrollData->momentumTime * 25);
+                scrollData->scrollMomentum.x = (scrollData->scrollPosition.x - scrollData->scrollOrigin.x) / (scrollData->momentumTime * 25) * 60;
             }
             float yDiff = scrollData->scrollPosition.y - scrollData->scrollOrigin.y;
             if (yDiff < -10 || yDiff > 10) {
-                scrollData->scrollMomentum.y = (scrollData->scrollPosition.y - scrollData->scrollOrigin.y) / (scrollData->momentumTime * 25);
+                scrollData->scrollMomentum.y = (scrollData->scrollPosition.y - scrollData->scrollOrigin.y) / (scrollData->momentumTime * 25) * 60;
             }
             scrollData->pointerScrollActive = false;
 
@@ -3251,27 +5067,25 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
             scrollData->momentumTime = 0;
         }
 
-        // Apply existing momentum
-        scrollData->scrollPosition.x += scrollData->scrollMomentum.x;
-        scrollData->scrollMomentum.x *= 0.95f;
+        // Apply existing momentum. It stops when it runs into either end, or when the wheel is used.
         bool scrollOccurred = scrollDelta.x != 0 || scrollDelta.y != 0;
-        if ((scrollData->scrollMomentum.x > -0.1f && scrollData->scrollMomentum.x < 0.1f) || scrollOccurred) {
+        scrollData->scrollPosition.x += Clay__ApplyScrollMomentum(&scrollData->scrollMomentum.x, deltaTime);
+        float clampedX = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.x, -(CLAY__MAX(scrollData->contentSize.width - scrollData->layoutElement->dimensions.width, 0))), 0);
+        if (clampedX != scrollData->scrollPosition.x || scrollOccurred) {
             scrollData->scrollMomentum.x = 0;
         }
-        scrollData->scrollPosition.x = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.x, -(CLAY__MAX(scrollData->contentSize.width - scrollData->layoutElement->dimensions.width, 0))), 0);
+        scrollData->scrollPosition.x = clampedX;
 
-        scrollData->scrollPosition.y += scrollData->scrollMomentum.y;
-        scrollData->scrollMomentum.y *= 0.95f;
-        if ((scrollData->scrollMomentum.y > -0.1f && scrollData->scrollMomentum.y < 0.1f) || scrollOccurred) {
+        scrollData->scrollPosition.y += Clay__ApplyScrollMomentum(&scrollData->scrollMomentum.y, deltaTime);
+        float clampedY = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.y, -(CLAY__MAX(scrollData->contentSize.height - scrollData->layoutElement->dimensions.height, 0))), 0);
+        if (clampedY != scrollData->scrollPosition.y || scrollOccurred) {
             scrollData->scrollMomentum.y = 0;
         }
-        scrollData->scrollPosition.y = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.y, -(CLAY__MAX(scrollData->contentSize.height - scrollData->layoutElement->dimensions.height, 0))), 0);
+        scrollData->scrollPosition.y = clampedY;
 
-        for (int32_t j = 0; j < context->pointerOverIds.length; ++j) { // TODO n & m are small here but this being n*m gives me the creeps
-            if (scrollData->layoutElement->id == Clay__ElementIdArray_Get(&context->pointerOverIds, j)->id) {
-                highestPriorityElementIndex = j;
-                highestPriorityScrollData = scrollData;
-            }
+        if (Clay__PointerOverId(scrollData->layoutElement->id)) {
+            highestPriorityElementIndex = i;
+            highestPriorityScrollData = scrollData;
         }
     }
 
@@ -3332,6 +5146,7 @@ void Clay_BeginLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__InitializeEphemeralMemory(context);
     context->generation++;
+    Clay__SweepLayoutElementHashMap(context->layoutElementsHashMapInternal.capacity / 64 + 1);
     context->dynamicElementIndex = 0;
     // Set up the root container that covers the entire window
     Clay_Dimensions rootDimensions = {context->layoutDimensions.width, context->layoutDimensions.height};
@@ -3339,6 +5154,9 @@ void Clay_BeginLayout(void) {
         rootDimensions.width -= (float)Clay__debugViewWidth;
     }
     context->booleanWarnings = CLAY__INIT(Clay_BooleanWarnings) CLAY__DEFAULT_STRUCT;
+    #ifndef CLAY_WASM
+    context->measureTextDeferred = Clay__MeasureTextParallel != NULL;
+    #endif
     Clay__OpenElement();
     CLAY_ID("Clay__RootContainer");
     CLAY_LAYOUT({ .sizing = {CLAY_SIZING_FIXED((rootDimensions.width)), CLAY_SIZING_FIXED(rootDimensions.height)} });
@@ -3347,12 +5165,35 @@ void Clay_BeginLayout(void) {
     Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) { .layoutElementIndex = 0 });
 }
 
+// Measures the text collected during layout declaration, then sizes every element to fit its children again now that the
+// text elements have their real dimensions. Children always come after their parent in layoutElements, so walking it
+// backwards visits them first, the same as Clay__CloseElement did.
+void Clay__FinishDeferredTextMeasurement(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasurePendingText();
+    context->measureTextDeferred = false;
+    if (!context->textElementsDeferred || context->booleanWarnings.maxElementsExceeded) {
+        context->textElementsDeferred = false;
+        return;
+    }
+    context->textElementsDeferred = false;
+    for (int32_t i = context->layoutElements.length - 1; i >= 0; --i) {
+        Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+        if (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            Clay__SizeElementToFitChildren(layoutElement);
+        }
+    }
+}
+
 Clay_TextElementConfig Clay__DebugView_ErrorTextConfig = {.textColor = {255, 0, 0, 255}, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE };
 
 CLAY_WASM_EXPORT("Clay_EndLayout")
 Clay_RenderCommandArray Clay_EndLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__CloseElement();
+    if (context->measureTextDeferred) {
+        Clay__FinishDeferredTextMeasurement();
+    }
     if (context->debugModeEnabled) {
         context->warningsEnabled = false;
         Clay__RenderDebugView();
@@ -3364,6 +5205,7 @@ Clay_RenderCommandArray Clay_EndLayout(void) {
     } else {
         Clay__CalculateFinalLayout();
     }
+    context->pointerEvents.length = 0;
     return context->renderCommands;
 }
 
@@ -3387,12 +5229,7 @@ bool Clay_Hovered(void) {
     if (openLayoutElement->id == 0) {
         Clay__GenerateIdForAnonymousElement(openLayoutElement);
     }
-    for (int32_t i = 0; i < context->pointerOverIds.length; ++i) {
-        if (Clay__ElementIdArray_Get(&context->pointerOverIds, i)->id == openLayoutElement->id) {
-            return true;
-        }
-    }
-    return false;
+    return Clay__PointerOverId(openLayoutElement->id);
 }
 
 void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData), intptr_t userData) {
@@ -3409,38 +5246,72 @@ void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_Pointer
     hashMapItem->hoverFunctionUserData = userData;
 }
 
+void Clay_OnPointerEvent(intptr_t userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    if (openLayoutElement->id == 0) {
+        Clay__GenerateIdForAnonymousElement(openLayoutElement);
+    }
+    Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(openLayoutElement->id);
+    if (hashMapItem == &Clay_LayoutElementHashMapItem_DEFAULT) {
+        return;
+    }
+    // Lapses as soon as the element is declared without it
+    hashMapItem->pointerEventGeneration = context->generation + 1;
+    hashMapItem->pointerEventUserData = userData;
+}
+
+CLAY_WASM_EXPORT("Clay_GetPointerEvents")
+Clay_PointerEventArray Clay_GetPointerEvents(void) {
+    return Clay_GetCurrentContext()->pointerEvents;
+}
+
 CLAY_WASM_EXPORT("Clay_PointerOver")
 bool Clay_PointerOver(Clay_ElementId elementId) { // TODO return priority for separating multiple results
+    return Clay__PointerOverId(elementId.id);
+}
+
+// Seconds until scroll momentum next moves a container by a pixel, or -1 if nothing is moving. Until then the host can sleep
+// rather than render, as long as it passes the whole time it slept to Clay_UpdateScrollContainers when it wakes up.
+CLAY_WASM_EXPORT("Clay_GetNextScrollUpdateDelay")
+float Clay_GetNextScrollUpdateDelay(void) {
     Clay_Context* context = Clay_GetCurrentContext();
-    for (int32_t i = 0; i < context->pointerOverIds.length; ++i) {
-        if (Clay__ElementIdArray_Get(&context->pointerOverIds, i)->id == elementId.id) {
-            return true;
+    float delay = -1;
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
+        Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        float axisDelays[2] = { Clay__ScrollMomentumPixelTime(scrollData->scrollMomentum.x), Clay__ScrollMomentumPixelTime(scrollData->scrollMomentum.y) };
+        for (int32_t axis = 0; axis < 2; axis++) {
+            if (axisDelays[axis] >= 0 && (delay < 0 || axisDelays[axis] < delay)) {
+                delay = axisDelays[axis];
+            }
         }
     }
-    return false;
+    return delay;
 }
 
 CLAY_WASM_EXPORT("Clay_GetScrollContainerData")
 Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-        if (scrollContainerData->elementId == id.id) {
-            return CLAY__INIT(Clay_ScrollContainerData) {
-                .scrollPosition = &scrollContainerData->scrollPosition,
-                .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
-                .contentDimensions = scrollContainerData->contentSize,
-                .config = *Clay__FindElementConfigWithType(scrollContainerData->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig,
-                .found = true
-            };
-        }
+    // Brings the container's bounding box up to date if it was inside a culled subtree
+    Clay_LayoutElementHashMapItem *hashItem = Clay__GetPositionedHashMapItem(id.id);
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetItemScrollContainerData(hashItem);
+    if (scrollContainerData) {
+        return CLAY__INIT(Clay_ScrollContainerData) {
+            .scrollPosition = &scrollContainerData->scrollPosition,
+            .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
+            .contentDimensions = scrollContainerData->contentSize,
+            .config = *Clay__FindElementConfigWithType(scrollContainerData->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig,
+            .found = true
+        };
     }
     return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
 }
 
 CLAY_WASM_EXPORT("Clay_GetElementData")
 Clay_ElementData Clay_GetElementData(Clay_ElementId id){
-    Clay_LayoutElementHashMapItem * item = Clay__GetHashMapItem(id.id);
+    Clay_LayoutElementHashMapItem * item = Clay__GetPositionedHashMapItem(id.id);
     if(item == &Clay_LayoutElementHashMapItem_DEFAULT) {
         return CLAY__INIT(Clay_ElementData) CLAY__DEFAULT_STRUCT;
     }
@@ -3516,6 +5387,13 @@ void Clay_ResetMeasureTextCache(void) {
     context->measureTextHashMap.length = 0;
     context->measuredWords.length = 0;
     context->measuredWordsFreeList.length = 0;
+    context->wrappedTextLinesCache.length = 0;
+    context->wrappedTextLinesCacheEpoch++;
+    context->wrappedTextLinesCacheFull = false;
+    context->layoutFingerprintEpoch++;
+    context->pendingTextMeasurements.length = 0;
+    context->textMeasurementRequests.length = 0;
+    context->deferredTextElements.length = 0;
     
     for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
         context->measureTextHashMap.internalArray[i] = 0;
@@ -3523,6 +5401,27 @@ void Clay_ResetMeasureTextCache(void) {
     context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
 }
 
+CLAY_WASM_EXPORT("Clay_GetMeasureTextCacheStatistics")
+Clay_MeasureTextCacheStatistics Clay_GetMeasureTextCacheStatistics(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_MeasureTextCacheStatistics statistics = context->measureTextCacheStatistics;
+    // Index 0 of the entry array is reserved, and freed slots stay inside length until they are reused
+    statistics.entryCapacity = context->measureTextHashMapInternal.capacity - 1;
+    statistics.entryFreeListLength = context->measureTextHashMapInternalFreeList.length;
+    statistics.liveEntries = context->measureTextHashMapInternal.length - 1 - statistics.entryFreeListLength;
+    statistics.wordCapacity = context->measuredWords.capacity;
+    statistics.wordFreeListLength = context->measuredWordsFreeList.length;
+    statistics.wordsHighWaterMark = context->measuredWords.length;
+    statistics.liveWords = context->measuredWords.length - statistics.wordFreeListLength;
+    return statistics;
+}
+
+// How many times since Clay_Initialize an element has been declared with an id that another, different element already had
+CLAY_WASM_EXPORT("Clay_GetElementIdCollisionCount")
+uint32_t Clay_GetElementIdCollisionCount(void) {
+    return Clay_GetCurrentContext()->elementIdCollisionCount;
+}
+
 #endif // CLAY_IMPLEMENTATION
 
 /*
@@ -2,6 +2,8 @@
 #include <cstring>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <chrono>
 #define CLAY_IMPLEMENTATION
 #include "./clay.h"
 #include "./raylib/clay_renderer_raylib.c"
@@ -30,12 +32,12 @@ void initClay(float windowWidth, float windowHeight, Clay_Dimensions (*measureTe
 //called to initialize Raylib //TODO, allow multiple fonts to be passed
 void initRaylib(uint32_t initialWidth, uint32_t initialHeight, const char* title, uint32_t fontIndex, const char* fontPath, uint32_t loadedFontSize){
     Clay_Raylib_Initialize(initialWidth, initialHeight, title, FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT);
-    Raylib_fonts[fontIndex] = (Raylib_Font) { 
-        .fontId = fontIndex,
-        .font = LoadFontEx(fontPath, loadedFontSize, 0, 400)
-    };
+    Raylib_LoadFont(fontIndex, fontPath, loadedFontSize);
 
     SetTextureFilter(Raylib_fonts[fontIndex].font.texture, TEXTURE_FILTER_BILINEAR);
+
+    //opt-in persistent text measurement cache next to the executable, must be opened after the fonts are loaded
+    Raylib_OpenMeasureTextCache(TextFormat("%smeasure_cache.bin", GetApplicationDirectory()), 1 << 16);
 }
 
 //called to render through raylib
@@ -142,6 +144,8 @@ bool oneshot = false;
 
 //for dynamic testing
 uint32_t framecount = 0;
+const double documentChangeTime = 200.0 / 60.0; //seconds after the window opens
+bool documentChangeDone = false;
 
 //raylib font index
 const int FONT_ID_BODY_16 = 0;
@@ -211,15 +215,15 @@ DocumentArray documents = {
 };
 uint32_t selectedDocumentIndex = 0;
 
-//callback for on-hover
-void HandleSidebarInteraction(
-    Clay_ElementId elementId,
-    Clay_PointerData pointerData,
-    intptr_t userData
-) {
-    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) { 
-        if (userData >= 0 && userData < documents.length) {
-            selectedDocumentIndex = userData;
+//drains the pointer events queued since the last layout
+void HandleSidebarInteraction() {
+    Clay_PointerEventArray events = Clay_GetPointerEvents();
+    for (int32_t i = 0; i < events.length; i++) {
+        Clay_PointerEvent *event = Clay_PointerEventArray_Get(&events, i);
+        if (event->type == CLAY_POINTER_EVENT_PRESS) { 
+            if (event->userData >= 0 && event->userData < documents.length) {
+                selectedDocumentIndex = event->userData;
+            }
         }
     }
 }
@@ -268,6 +272,7 @@ void RenderDropdownMenuItem(Clay_String text) {
 //////////////////////////main layout function//////////////////////////////////
 
 Clay_RenderCommandArray buildLayout(){
+    HandleSidebarInteraction();
     Clay_BeginLayout(); //START LAYOUT
 
     Clay__OpenElement(), //macro 1 (has been converted from for loop to linear, close element call is at end of function)
@@ -425,7 +430,7 @@ Clay_RenderCommandArray buildLayout(){
                         CLAY__ELEMENT_DEFINITION_LATCH = (
                             Clay__OpenElement(), 
                             Clay__AttachLayoutConfig(Clay__StoreLayoutConfig((Clay__Clay_LayoutConfigWrapper { sidebarButtonLayout }).wrapped)), 
-                            Clay_OnHover(HandleSidebarInteraction, i), 
+                            Clay_OnPointerEvent(i), 
                             Clay_Hovered()? 
                                 Clay__AttachElementConfig(Clay_ElementConfigUnion { .rectangleElementConfig = Clay__StoreRectangleElementConfig((Clay__Clay_RectangleElementConfigWrapper { { .color = { 120, 120, 120, 120 }, .cornerRadius = 8 } }).wrapped) }, CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE) 
                                 : (void)0, 
@@ -469,13 +474,345 @@ Clay_RenderCommandArray buildLayout(){
     return Clay_EndLayout(); //END LAYOUT
 }
 
+/////////////////////////////////////////////////////////////////////
+///////////////////////recording and replay//////////////////////////
+
+// A recording starts with a header and the glyph advances of every loaded font, so a replay can measure text exactly as
+// the recorded session did without opening a window. Every frame after that is the input passed to updateClayStateInput,
+// followed by the documents that were replaced once the frame was laid out. Values are in the recording machine's byte order.
+const uint32_t RECORDING_MAGIC = 0x43524c43; // "CLRC"
+const uint32_t RECORDING_VERSION = 1;
+const uint8_t RECORDING_FLAG_LEFT_BUTTON_DOWN = 1;
+const uint8_t RECORDING_FLAG_DOCUMENT_MUTATIONS = 2; // followed by a uint32_t count and that many mutations
+
+//everything Clay is told about the outside world in one frame
+typedef struct {
+    float windowWidth;
+    float windowHeight;
+    float mouseX;
+    float mouseY;
+    float scrollDeltaX;
+    float scrollDeltaY;
+    float frameTime;
+    bool leftButtonDown;
+} FrameInput;
+
+//a document replaced between two frames
+typedef struct {
+    uint32_t index;
+    Document document;
+} DocumentMutation;
+
+//a frame read back from a recording
+typedef struct {
+    FrameInput input;
+    std::vector<DocumentMutation> mutations;
+} RecordedFrame;
+
+//glyph advances of a font slot, as Raylib_MeasureText would have used them
+typedef struct {
+    int32_t baseSize;
+    std::vector<float> advances;
+} RecordedFont;
+
+//the open recording, if the session is being recorded
+FILE *recordingFile = NULL;
+std::vector<DocumentMutation> pendingDocumentMutations;
+
+//fonts read back from the recording being replayed
+std::vector<RecordedFont> replayFonts;
+
+void applyFrameInput(const FrameInput& input){
+    updateClayStateInput(input.windowWidth, input.windowHeight, input.mouseX, input.mouseY, input.scrollDeltaX, input.scrollDeltaY, input.frameTime, input.leftButtonDown);
+}
+
+//replaces a document, and records the change when recording
+void setDocument(uint32_t index, const Document& document){
+    documents.documents[index] = document;
+    if(recordingFile){
+        pendingDocumentMutations.push_back({ index, document });
+    }
+}
+
+void writeRecordingString(const std::string& str){
+    uint32_t length = static_cast<uint32_t>(str.size());
+    fwrite(&length, sizeof(length), 1, recordingFile);
+    fwrite(str.data(), 1, length, recordingFile);
+}
+
+//opens the recording and writes its header, must be called after the fonts are loaded
+bool startRecording(const char* path){
+    recordingFile = fopen(path, "wb");
+    if(!recordingFile){
+        return false;
+    }
+    uint32_t header[3] = { RECORDING_MAGIC, RECORDING_VERSION, static_cast<uint32_t>(sizeof(Raylib_fonts) / sizeof(Raylib_fonts[0])) };
+    fwrite(header, sizeof(header), 1, recordingFile);
+    for(uint32_t i = 0; i < header[2]; i++){
+        Font& font = Raylib_fonts[i].font;
+        int32_t baseSize = font.baseSize;
+        uint32_t glyphCount = font.glyphs ? static_cast<uint32_t>(font.glyphCount) : 0;
+        fwrite(&baseSize, sizeof(baseSize), 1, recordingFile);
+        fwrite(&glyphCount, sizeof(glyphCount), 1, recordingFile);
+        for(uint32_t glyph = 0; glyph < glyphCount; glyph++){
+            float advance = font.glyphs[glyph].advanceX != 0 ? static_cast<float>(font.glyphs[glyph].advanceX) : font.recs[glyph].width + font.glyphs[glyph].offsetX;
+            fwrite(&advance, sizeof(advance), 1, recordingFile);
+        }
+    }
+    return true;
+}
+
+//writes one frame, along with the documents replaced since the previous one
+void recordFrame(const FrameInput& input){
+    if(!recordingFile){
+        return;
+    }
+    float values[7] = { input.windowWidth, input.windowHeight, input.mouseX, input.mouseY, input.scrollDeltaX, input.scrollDeltaY, input.frameTime };
+    uint8_t flags = (input.leftButtonDown ? RECORDING_FLAG_LEFT_BUTTON_DOWN : 0) | (pendingDocumentMutations.empty() ? 0 : RECORDING_FLAG_DOCUMENT_MUTATIONS);
+    fwrite(values, sizeof(values), 1, recordingFile);
+    fwrite(&flags, sizeof(flags), 1, recordingFile);
+    if(flags & RECORDING_FLAG_DOCUMENT_MUTATIONS){
+        uint32_t count = static_cast<uint32_t>(pendingDocumentMutations.size());
+        fwrite(&count, sizeof(count), 1, recordingFile);
+        for(const DocumentMutation& mutation : pendingDocumentMutations){
+            fwrite(&mutation.index, sizeof(mutation.index), 1, recordingFile);
+            writeRecordingString(mutation.document.title);
+            writeRecordingString(mutation.document.contents);
+        }
+        pendingDocumentMutations.clear();
+    }
+}
+
+void stopRecording(){
+    if(recordingFile){
+        fclose(recordingFile);
+        recordingFile = NULL;
+    }
+}
+
+//cursor over a recording that has been read into memory
+typedef struct {
+    std::vector<unsigned char> data;
+    size_t offset;
+    bool failed;
+} RecordingReader;
+
+bool readRecordingValue(RecordingReader& reader, void* value, size_t size){
+    if(reader.failed || reader.data.size() - reader.offset < size){
+        reader.failed = true;
+        return false;
+    }
+    memcpy(value, reader.data.data() + reader.offset, size);
+    reader.offset += size;
+    return true;
+}
+
+bool readRecordingString(RecordingReader& reader, std::string& str){
+    uint32_t length = 0;
+    if(!readRecordingValue(reader, &length, sizeof(length)) || reader.data.size() - reader.offset < length){
+        reader.failed = true;
+        return false;
+    }
+    str.assign(reinterpret_cast<const char*>(reader.data.data() + reader.offset), length);
+    reader.offset += length;
+    return true;
+}
+
+//reads the fonts and every frame of a recording, so that replaying it doesn't wait on the disk
+bool readRecording(const char* path, std::vector<RecordedFrame>& frames){
+    FILE* file = fopen(path, "rb");
+    if(!file){
+        return false;
+    }
+    RecordingReader reader = { {}, 0, false };
+    unsigned char chunk[1 << 16];
+    size_t chunkLength;
+    while((chunkLength = fread(chunk, 1, sizeof(chunk), file)) > 0){
+        reader.data.insert(reader.data.end(), chunk, chunk + chunkLength);
+    }
+    fclose(file);
+
+    uint32_t header[3];
+    if(!readRecordingValue(reader, header, sizeof(header)) || header[0] != RECORDING_MAGIC || header[1] != RECORDING_VERSION){
+        return false;
+    }
+    replayFonts.assign(header[2], RecordedFont{ 0, {} });
+    for(RecordedFont& font : replayFonts){
+        uint32_t glyphCount = 0;
+        readRecordingValue(reader, &font.baseSize, sizeof(font.baseSize));
+        readRecordingValue(reader, &glyphCount, sizeof(glyphCount));
+        if(reader.failed || reader.data.size() - reader.offset < glyphCount * sizeof(float)){
+            return false;
+        }
+        font.advances.resize(glyphCount);
+        if(glyphCount > 0){
+            readRecordingValue(reader, font.advances.data(), glyphCount * sizeof(float));
+        }
+    }
+
+    while(reader.offset < reader.data.size()){
+        RecordedFrame frame;
+        float values[7];
+        uint8_t flags = 0;
+        readRecordingValue(reader, values, sizeof(values));
+        readRecordingValue(reader, &flags, sizeof(flags));
+        frame.input = { values[0], values[1], values[2], values[3], values[4], values[5], values[6], (flags & RECORDING_FLAG_LEFT_BUTTON_DOWN) != 0 };
+        if(flags & RECORDING_FLAG_DOCUMENT_MUTATIONS){
+            uint32_t count = 0;
+            readRecordingValue(reader, &count, sizeof(count));
+            for(uint32_t i = 0; i < count && !reader.failed; i++){
+                DocumentMutation mutation;
+                readRecordingValue(reader, &mutation.index, sizeof(mutation.index));
+                readRecordingString(reader, mutation.document.title);
+                readRecordingString(reader, mutation.document.contents);
+                frame.mutations.push_back(mutation);
+            }
+        }
+        if(reader.failed){
+            //a session that ended without closing the window can leave a partial frame at the end
+            break;
+        }
+        frames.push_back(frame);
+    }
+    return true;
+}
+
+//mirrors Raylib_MeasureText using the glyph advances stored in the recording
+Clay_Dimensions measureTextReplay(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData){
+    Clay_Dimensions textSize = { 0 };
+    if(config->fontId >= replayFonts.size() || replayFonts[config->fontId].advances.empty()){
+        return textSize;
+    }
+    const RecordedFont& font = replayFonts[config->fontId];
+
+    float maxTextWidth = 0.0f;
+    float lineTextWidth = 0;
+    for(int32_t i = 0; i < text.length; ++i){
+        if(text.chars[i] == '\n'){
+            maxTextWidth = std::max(maxTextWidth, lineTextWidth);
+            lineTextWidth = 0;
+            continue;
+        }
+        size_t index = static_cast<size_t>(text.chars[i] - 32);
+        if(index < font.advances.size()){
+            lineTextWidth += font.advances[index];
+        }
+    }
+    maxTextWidth = std::max(maxTextWidth, lineTextWidth);
+
+    textSize.width = maxTextWidth * (config->fontSize / (float)font.baseSize);
+    textSize.height = config->fontSize;
+    return textSize;
+}
+
+//64 bit FNV-1a over what each render command draws. Configs are hashed by value, field by field so that padding and
+//pointers that differ between runs don't leak in.
+uint64_t hashRenderCommands(Clay_RenderCommandArray renderCommands){
+    uint64_t hash = RAYLIB_HASH_SEED;
+    for(int32_t i = 0; i < renderCommands.length; i++){
+        Clay_RenderCommand* renderCommand = Clay_RenderCommandArray_Get(&renderCommands, i);
+        hash = Raylib_HashBytes(hash, &renderCommand->boundingBox, sizeof(renderCommand->boundingBox));
+        hash = Raylib_HashBytes(hash, &renderCommand->zIndex, sizeof(renderCommand->zIndex));
+        hash = Raylib_HashBytes(hash, &renderCommand->id, sizeof(renderCommand->id));
+        hash = Raylib_HashBytes(hash, &renderCommand->commandType, sizeof(renderCommand->commandType));
+        switch(renderCommand->commandType){
+            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+                Clay_RectangleElementConfig* config = renderCommand->config.rectangleElementConfig;
+                hash = Raylib_HashBytes(hash, &config->color, sizeof(config->color));
+                hash = Raylib_HashBytes(hash, &config->cornerRadius, sizeof(config->cornerRadius));
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+                Clay_BorderElementConfig* config = renderCommand->config.borderElementConfig;
+                Clay_Border borders[5] = { config->left, config->right, config->top, config->bottom, config->betweenChildren };
+                for(const Clay_Border& border : borders){
+                    hash = Raylib_HashBytes(hash, &border.width, sizeof(border.width));
+                    hash = Raylib_HashBytes(hash, &border.color, sizeof(border.color));
+                }
+                hash = Raylib_HashBytes(hash, &config->cornerRadius, sizeof(config->cornerRadius));
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+                Clay_TextElementConfig* config = renderCommand->config.textElementConfig;
+                hash = Raylib_HashBytes(hash, &renderCommand->text.length, sizeof(renderCommand->text.length));
+                hash = Raylib_HashBytes(hash, renderCommand->text.chars, static_cast<size_t>(renderCommand->text.length));
+                hash = Raylib_HashBytes(hash, &config->textColor, sizeof(config->textColor));
+                hash = Raylib_HashBytes(hash, &config->fontId, sizeof(config->fontId));
+                hash = Raylib_HashBytes(hash, &config->fontSize, sizeof(config->fontSize));
+                hash = Raylib_HashBytes(hash, &config->letterSpacing, sizeof(config->letterSpacing));
+                hash = Raylib_HashBytes(hash, &config->lineHeight, sizeof(config->lineHeight));
+                break;
+            }
+            default: break;
+        }
+    }
+    return hash;
+}
+
+//lays out every frame of a recording back to back without a window, printing how long each took and a hash of what it
+//would have drawn. Runs of the same recording should print the same hashes; the timings are what's being compared.
+int replaySession(const char* path){
+    std::vector<RecordedFrame> frames;
+    if(!readRecording(path, frames)){
+        printf("could not read recording %s\n", path);
+        return 1;
+    }
+    FrameInput firstInput = frames.empty() ? FrameInput{ 1024, 768 } : frames[0].input;
+    initClay(firstInput.windowWidth, firstInput.windowHeight, measureTextReplay);
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(frames.size());
+    uint64_t sessionHash = RAYLIB_HASH_SEED;
+    for(size_t i = 0; i < frames.size(); i++){
+        auto start = std::chrono::steady_clock::now();
+        applyFrameInput(frames[i].input);
+        Clay_RenderCommandArray renderCommands = buildLayout();
+        auto end = std::chrono::steady_clock::now();
+
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        uint64_t hash = hashRenderCommands(renderCommands);
+        sessionHash = Raylib_HashBytes(sessionHash, &hash, sizeof(hash));
+        frameTimes.push_back(milliseconds);
+        printf("frame %zu %.3f ms %d commands %016llx\n", i, milliseconds, renderCommands.length, (unsigned long long)hash);
+
+        clearClayStringBuffers();
+        for(const DocumentMutation& mutation : frames[i].mutations){
+            if(mutation.index < documents.length){
+                documents.documents[mutation.index] = mutation.document;
+            }
+        }
+    }
+
+    if(frameTimes.empty()){
+        printf("no frames in %s\n", path);
+        return 0;
+    }
+    double total = 0;
+    for(double milliseconds : frameTimes){
+        total += milliseconds;
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+    printf("frames %zu total %.3f ms mean %.3f ms median %.3f ms p95 %.3f ms max %.3f ms session %016llx\n",
+        frameTimes.size(), total, total / frameTimes.size(), frameTimes[frameTimes.size() / 2],
+        frameTimes[std::min(frameTimes.size() - 1, frameTimes.size() * 95 / 100)], frameTimes.back(), (unsigned long long)sessionHash);
+    return 0;
+}
+
 /////////////////////////////////////////////////////////////////////
 ///////////////////////application///////////////////////////////////
-int main(void) {
+//  --record <file>  records the session's input and document changes to file
+//  --replay <file>  lays out a recorded session without a window and reports per frame timings
+int main(int argc, char* argv[]) {
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+    for(int i = 1; i + 1 < argc; i++){
+        if(strcmp(argv[i], "--record") == 0){
+            recordPath = argv[++i];
+        }else if(strcmp(argv[i], "--replay") == 0){
+            replayPath = argv[++i];
+        }
+    }
 
-    //initialize Clay and Raylib
-    initRaylib(1024, 768, "Clay C++ No Macros Introductory Video Example", FONT_ID_BODY_16, "resources/Roboto-Regular.ttf", 48);
-    initClay((float)GetScreenWidth(), (float)GetScreenHeight(), Raylib_MeasureText);
 
     //define initial data
     Document docs[] = {
@@ -488,13 +825,27 @@ int main(void) {
     documents.documents = docs;
     documents.length = 5;
 
+    if(replayPath){
+        return replaySession(replayPath);
+    }
+
+    //initialize Clay and Raylib
+    initRaylib(1024, 768, "Clay C++ No Macros Introductory Video Example", FONT_ID_BODY_16, "resources/Roboto-Regular.ttf", 48);
+    initClay((float)GetScreenWidth(), (float)GetScreenHeight(), Raylib_MeasureText);
+
+    //the fonts have to be loaded first, their glyph advances are part of the recording
+    if(recordPath && !startRecording(recordPath)){
+        printf("could not open %s for recording\n", recordPath);
+    }
+
     /////////////////////begin application loop
     while (!WindowShouldClose()) {
 
         //update Clay state
         Vector2 mousePosition = GetMousePosition();
         Vector2 scrollDelta = GetMouseWheelMoveV();
-        updateClayStateInput((float)GetScreenWidth(), (float)GetScreenHeight(), mousePosition.x, mousePosition.y, scrollDelta.x, scrollDelta.y, GetFrameTime(), IsMouseButtonDown(0));
+        FrameInput input = { (float)GetScreenWidth(), (float)GetScreenHeight(), mousePosition.x, mousePosition.y, scrollDelta.x, scrollDelta.y, GetFrameTime(), IsMouseButtonDown(0) };
+        applyFrameInput(input);
 
         
 
@@ -512,11 +863,27 @@ int main(void) {
             framecount = 0;
         }
 
-        if(framecount == 200){
-            docs[2] = {"Change-up", "Testing the dynamic ability of strings with C++ magic!"};
-        }else if(framecount == 400){ 
-            //TODO add new document dynamically, may require vector...
+        //timed rather than counted in frames, while the window waits for events frames only come with input
+        bool documentChanged = false;
+        if(!documentChangeDone && GetTime() >= documentChangeTime){
+            setDocument(2, {"Change-up", "Testing the dynamic ability of strings with C++ magic!"});
+            documentChangeDone = true;
+            documentChanged = true;
+        }
+        //TODO add new document dynamically, may require vector...
+
+        //sleep until the next input event, unless scroll momentum still has somewhere to go, the document change is still
+        //to come, or the layout has just changed and the next frame has to draw it
+        if(Clay_GetNextScrollUpdateDelay() < 0 && documentChangeDone && !documentChanged){
+            EnableEventWaiting();
+        }else{
+            DisableEventWaiting();
         }
+
+        recordFrame(input);
     }
+
+    stopRecording();
+    Raylib_CloseMeasureTextCache();
     return 0;
 }
\ No newline at end of file
@@ -4,6 +4,12 @@
 #include "string.h"
 #include "stdio.h"
 #include "stdlib.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #define CLAY_RECTANGLE_TO_RAYLIB_RECTANGLE(rectangle) (Rectangle) { .x = rectangle.x, .y = rectangle.y, .width = rectangle.width, .height = rectangle.height }
 #define CLAY_COLOR_TO_RAYLIB_COLOR(color) (Color) { .r = (unsigned char)roundf(color.r), .g = (unsigned char)roundf(color.g), .b = (unsigned char)roundf(color.b), .a = (unsigned char)roundf(color.a) }
@@ -12,6 +18,7 @@ typedef struct
 {
     uint32_t fontId;
     Font font;
+    uint64_t fileHash; // Hash of the font file contents, set by Raylib_LoadFont and used to key the persistent measure cache
 } Raylib_Font;
 
 Raylib_Font Raylib_fonts[10];
@@ -88,7 +95,283 @@ Ray GetScreenToWorldPointWithZDistance(Vector2 position, Camera camera, int scre
 }
 
 
-static inline Clay_Dimensions Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData) {
+static inline uint64_t Raylib_HashBytes(uint64_t hash, const void *data, size_t length) {
+    // 64 bit FNV-1a
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+#define RAYLIB_HASH_SEED 0xcbf29ce484222325ULL
+
+// A second 64 bit hash that shares nothing with FNV-1a, used to tell apart texts whose FNV-1a hashes collide
+static inline uint64_t Raylib_HashBytesCheck(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash + bytes[i] + 1) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+// Loads a font into Raylib_fonts[fontId], reading the file once so that its contents can also be hashed
+// for the persistent measure cache.
+bool Raylib_LoadFont(uint32_t fontId, const char *fontPath, int fontSize) {
+    int dataSize = 0;
+    unsigned char *fileData = LoadFileData(fontPath, &dataSize);
+    if (!fileData) return false;
+    Raylib_fonts[fontId] = (Raylib_Font) {
+        .fontId = fontId,
+        .font = LoadFontFromMemory(GetFileExtension(fontPath), fileData, dataSize, fontSize, 0, 400),
+        .fileHash = Raylib_HashBytes(RAYLIB_HASH_SEED, fileData, (size_t)dataSize)
+    };
+    UnloadFileData(fileData);
+    return Raylib_fonts[fontId].font.glyphs != NULL;
+}
+
+// -----------------------------------------
+// Persistent text measurement cache (opt-in)
+// -----------------------------------------
+// Measurement results are stored in a flat open addressed table that lives directly in a memory mapped file,
+// so opening an existing cache involves no parsing, only a header check. Entries are keyed by the font's file
+// hash, the size the font was loaded at, the requested font size, letter spacing and a hash of the measured text. The text
+// isn't stored, so each entry also keeps a second, independent hash of the same inputs that has to match as well. Two
+// different texts would have to collide in both 64 bit hashes for one to be given the other's width.
+// A clock in the header ticks on every miss, and entries are stamped with it when they're used. Once the table is as full
+// as it's allowed to get, new text makes room by evicting the least recently used of the next few entries after a sweep
+// position that moves through the table. The next open rebuilds a full table with only its most recently used half, at
+// the requested capacity if that's grown.
+// On platforms without mmap the file is read into memory on open and written back on close.
+
+#define RAYLIB_MEASURE_CACHE_MAGIC 0x4d54434cu // "LCTM"
+#define RAYLIB_MEASURE_CACHE_VERSION 3u
+#define RAYLIB_MEASURE_CACHE_MAX_CAPACITY (1u << 30)
+#define RAYLIB_MEASURE_CACHE_MAX_PROBES 64 // Past this many slots the text is measured uncached rather than searched for
+#define RAYLIB_MEASURE_CACHE_SWEEP_ENTRIES 8 // How many entries the sweep looks at to pick one to evict
+#define RAYLIB_MEASURE_CACHE_MAX_FONTS (sizeof(Raylib_fonts) / sizeof(Raylib_fonts[0]))
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity; // Always a power of two
+    uint32_t length;
+    uint32_t clock; // Ticks on every miss
+    uint32_t sweep; // The slot the next search for an entry to evict starts at
+    uint64_t fontFingerprints[RAYLIB_MEASURE_CACHE_MAX_FONTS]; // Fingerprint of each Raylib_fonts slot the entries were measured with
+} Raylib_MeasureCacheHeader;
+
+typedef struct
+{
+    uint64_t key; // 0 marks an empty slot
+    uint64_t check; // Raylib_HashBytesCheck of the same inputs as the key
+    float width;
+    float height;
+    uint32_t lastUsed; // The clock when the entry was last used
+} Raylib_MeasureCacheEntry;
+
+typedef struct
+{
+    Raylib_MeasureCacheHeader *header;
+    Raylib_MeasureCacheEntry *entries;
+    size_t mappedSize;
+    bool memoryMapped;
+    char *path;
+} Raylib_MeasureCache;
+
+Raylib_MeasureCache Raylib_measureCache;
+
+static inline uint64_t Raylib_FontFingerprint(uint32_t fontId) {
+    Raylib_Font *font = &Raylib_fonts[fontId];
+    if (!font->font.glyphs) return 0;
+    uint64_t fingerprint = Raylib_HashBytes(RAYLIB_HASH_SEED, &font->fileHash, sizeof(font->fileHash));
+    fingerprint = Raylib_HashBytes(fingerprint, &font->font.baseSize, sizeof(font->font.baseSize));
+    return Raylib_HashBytes(fingerprint, &font->font.glyphCount, sizeof(font->font.glyphCount));
+}
+
+// Keep the table at most 3/4 full so probes stay short
+static inline uint32_t Raylib_MeasureCacheLoadLimit(uint32_t capacity) {
+    return capacity - capacity / 4;
+}
+
+// Puts entry into the first empty slot of its probe, for tables known to have room
+static void Raylib_MeasureCacheInsert(Raylib_MeasureCacheHeader *header, Raylib_MeasureCacheEntry *entries, Raylib_MeasureCacheEntry entry) {
+    uint32_t mask = header->capacity - 1;
+    uint32_t slot = (uint32_t)entry.key & mask;
+    while (entries[slot].key != 0) slot = (slot + 1) & mask;
+    entries[slot] = entry;
+    header->length++;
+}
+
+// Empties slot, moving later entries of the cluster back into it so that every entry stays reachable from its home slot
+static void Raylib_MeasureCacheRemove(Raylib_MeasureCacheHeader *header, Raylib_MeasureCacheEntry *entries, uint32_t slot) {
+    uint32_t mask = header->capacity - 1;
+    for (uint32_t next = (slot + 1) & mask; entries[next].key != 0; next = (next + 1) & mask) {
+        // An entry can move back to the empty slot unless its home slot lies after the empty one
+        uint32_t home = (uint32_t)entries[next].key & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            entries[slot] = entries[next];
+            slot = next;
+        }
+    }
+    entries[slot] = (Raylib_MeasureCacheEntry) { 0 };
+    header->length--;
+}
+
+// Evicts the least recently used of the next few entries from the sweep position, and moves the sweep past them
+static void Raylib_MeasureCacheEvict(Raylib_MeasureCacheHeader *header, Raylib_MeasureCacheEntry *entries) {
+    uint32_t mask = header->capacity - 1;
+    uint32_t slot = header->sweep & mask, evicted = 0, seen = 0;
+    for (uint32_t i = 0; i < header->capacity && seen < RAYLIB_MEASURE_CACHE_SWEEP_ENTRIES; ++i, slot = (slot + 1) & mask) {
+        if (entries[slot].key == 0) continue;
+        if (seen++ == 0 || header->clock - entries[slot].lastUsed > header->clock - entries[evicted].lastUsed) evicted = slot;
+    }
+    header->sweep = slot;
+    if (seen > 0) Raylib_MeasureCacheRemove(header, entries, evicted);
+}
+
+// Sorts live entries before empty slots, most recently used first
+static int Raylib_MeasureCacheCompareRecency(const void *a, const void *b) {
+    const Raylib_MeasureCacheEntry *entryA = (const Raylib_MeasureCacheEntry *)a, *entryB = (const Raylib_MeasureCacheEntry *)b;
+    if ((entryA->key == 0) != (entryB->key == 0)) return entryA->key == 0 ? 1 : -1;
+    int32_t difference = (int32_t)(entryB->lastUsed - entryA->lastUsed); // Stays right when the clock wraps around
+    return (difference > 0) - (difference < 0);
+}
+
+// Moves the most recently used entries of a full or smaller table into a new empty one, filling it no more than half way
+static void Raylib_MeasureCacheRebuild(Raylib_MeasureCacheHeader *header, Raylib_MeasureCacheEntry *entries, Raylib_MeasureCacheEntry *oldEntries, uint32_t oldCapacity) {
+    qsort(oldEntries, oldCapacity, sizeof(Raylib_MeasureCacheEntry), Raylib_MeasureCacheCompareRecency);
+    for (uint32_t i = 0; i < oldCapacity && oldEntries[i].key != 0 && header->length < header->capacity / 2; ++i) {
+        Raylib_MeasureCacheInsert(header, entries, oldEntries[i]);
+    }
+}
+
+// Opens (or creates) the cache file at path, with room for capacity entries rounded up to a power of two. An existing file
+// keeps its entries, and is rebuilt at the larger capacity when it's asked for, or with fewer entries when it's full. Entries
+// measured with a font that no longer matches the loaded Raylib_fonts entry in the same slot cause the whole table to be
+// discarded.
+bool Raylib_OpenMeasureTextCache(const char *path, uint32_t capacity) {
+    if (Raylib_measureCache.header) return true;
+    uint32_t powerOfTwoCapacity = 64;
+    while (powerOfTwoCapacity < capacity && powerOfTwoCapacity < RAYLIB_MEASURE_CACHE_MAX_CAPACITY) powerOfTwoCapacity <<= 1;
+
+    Raylib_MeasureCacheHeader expected = { .magic = RAYLIB_MEASURE_CACHE_MAGIC, .version = RAYLIB_MEASURE_CACHE_VERSION, .capacity = powerOfTwoCapacity };
+    for (uint32_t i = 0; i < RAYLIB_MEASURE_CACHE_MAX_FONTS; ++i) {
+        expected.fontFingerprints[i] = Raylib_FontFingerprint(i);
+    }
+
+    Raylib_MeasureCacheHeader existing = { 0 };
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        if (fread(&existing, sizeof(existing), 1, file) != 1) existing.magic = 0;
+    }
+    // The file may be corrupt or not a cache at all, so don't let it pick a huge size or claim a table too full to probe
+    bool valid = existing.magic == RAYLIB_MEASURE_CACHE_MAGIC && existing.version == RAYLIB_MEASURE_CACHE_VERSION
+        && existing.capacity > 0 && existing.capacity <= RAYLIB_MEASURE_CACHE_MAX_CAPACITY && (existing.capacity & (existing.capacity - 1)) == 0
+        && existing.length < existing.capacity;
+    for (uint32_t i = 0; valid && i < RAYLIB_MEASURE_CACHE_MAX_FONTS; ++i) {
+        if (expected.fontFingerprints[i] != 0 && existing.fontFingerprints[i] != expected.fontFingerprints[i]) valid = false;
+    }
+    // A file that has to be rebuilt is read in whole, and written over with the new table
+    Raylib_MeasureCacheEntry *oldEntries = NULL;
+    bool rebuild = valid && (existing.capacity < expected.capacity || existing.length >= Raylib_MeasureCacheLoadLimit(existing.capacity));
+    if (rebuild) {
+        oldEntries = (Raylib_MeasureCacheEntry *)malloc((size_t)existing.capacity * sizeof(Raylib_MeasureCacheEntry));
+        if (!oldEntries || fread(oldEntries, sizeof(Raylib_MeasureCacheEntry), existing.capacity, file) != existing.capacity) {
+            rebuild = valid = false;
+        }
+    }
+    if (file) fclose(file);
+    expected.clock = valid ? existing.clock : 0;
+    if (valid && !rebuild) {
+        expected.capacity = existing.capacity;
+        expected.length = existing.length;
+        expected.sweep = existing.sweep;
+    }
+    size_t size = sizeof(Raylib_MeasureCacheHeader) + (size_t)expected.capacity * sizeof(Raylib_MeasureCacheEntry);
+
+    void *memory = NULL;
+#if !defined(_WIN32)
+    int fd = open(path, O_RDWR | O_CREAT | (valid && !rebuild ? 0 : O_TRUNC), 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)size) != 0) {
+        if (fd >= 0) close(fd);
+        free(oldEntries);
+        return false;
+    }
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        free(oldEntries);
+        return false;
+    }
+    Raylib_measureCache.memoryMapped = true;
+#else
+    memory = calloc(1, size);
+    if (!memory) {
+        free(oldEntries);
+        return false;
+    }
+    if (valid && !rebuild && (file = fopen(path, "rb"))) {
+        if (fread(memory, size, 1, file) != 1) valid = false;
+        fclose(file);
+    }
+    Raylib_measureCache.memoryMapped = false;
+#endif
+    Raylib_measureCache.header = (Raylib_MeasureCacheHeader *)memory;
+    Raylib_measureCache.entries = (Raylib_MeasureCacheEntry *)(Raylib_measureCache.header + 1);
+    Raylib_measureCache.mappedSize = size;
+    Raylib_measureCache.path = strdup(path);
+    if (!valid || rebuild) {
+        memset(memory, 0, size);
+        expected.length = 0;
+    }
+    // Fonts that weren't loaded when the file was written may have been loaded since
+    *Raylib_measureCache.header = expected;
+    if (rebuild) {
+        Raylib_MeasureCacheRebuild(Raylib_measureCache.header, Raylib_measureCache.entries, oldEntries, existing.capacity);
+        free(oldEntries);
+    }
+    return true;
+}
+
+void Raylib_CloseMeasureTextCache(void) {
+    if (!Raylib_measureCache.header) return;
+#if !defined(_WIN32)
+    msync(Raylib_measureCache.header, Raylib_measureCache.mappedSize, MS_ASYNC);
+    munmap(Raylib_measureCache.header, Raylib_measureCache.mappedSize);
+#else
+    FILE *file = fopen(Raylib_measureCache.path, "wb");
+    if (file) {
+        fwrite(Raylib_measureCache.header, Raylib_measureCache.mappedSize, 1, file);
+        fclose(file);
+    }
+    free(Raylib_measureCache.header);
+#endif
+    free(Raylib_measureCache.path);
+    Raylib_measureCache = (Raylib_MeasureCache) { 0 };
+}
+
+static inline uint64_t Raylib_MeasureCacheKey(Clay_StringSlice text, Clay_TextElementConfig *config) {
+    uint64_t key = Raylib_measureCache.header->fontFingerprints[config->fontId];
+    key = Raylib_HashBytes(key, &config->fontSize, sizeof(config->fontSize));
+    key = Raylib_HashBytes(key, &config->letterSpacing, sizeof(config->letterSpacing));
+    key = Raylib_HashBytes(key, &text.length, sizeof(text.length));
+    key = Raylib_HashBytes(key, text.chars, (size_t)text.length);
+    return key ? key : 1;
+}
+
+static inline uint64_t Raylib_MeasureCacheCheck(Clay_StringSlice text, Clay_TextElementConfig *config) {
+    uint64_t check = Raylib_HashBytesCheck(0, &Raylib_measureCache.header->fontFingerprints[config->fontId], sizeof(uint64_t));
+    check = Raylib_HashBytesCheck(check, &config->fontSize, sizeof(config->fontSize));
+    check = Raylib_HashBytesCheck(check, &config->letterSpacing, sizeof(config->letterSpacing));
+    check = Raylib_HashBytesCheck(check, &text.length, sizeof(text.length));
+    return Raylib_HashBytesCheck(check, text.chars, (size_t)text.length);
+}
+
+static inline Clay_Dimensions Raylib_MeasureTextUncached(Clay_StringSlice text, Clay_TextElementConfig *config) {
     // Measure string size for Font
     Clay_Dimensions textSize = { 0 };
 
@@ -122,6 +405,43 @@ static inline Clay_Dimensions Raylib_MeasureText(Clay_StringSlice text, Clay_Tex
     return textSize;
 }
 
+static inline Clay_Dimensions Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData) {
+    Raylib_MeasureCacheHeader *header = Raylib_measureCache.header;
+    if (!header || config->fontId >= RAYLIB_MEASURE_CACHE_MAX_FONTS || !header->fontFingerprints[config->fontId]) {
+        return Raylib_MeasureTextUncached(text, config);
+    }
+    uint64_t key = Raylib_MeasureCacheKey(text, config);
+    uint64_t check = Raylib_MeasureCacheCheck(text, config);
+    uint32_t mask = header->capacity - 1;
+    uint32_t slot = (uint32_t)key & mask;
+    Raylib_MeasureCacheEntry *entry = &Raylib_measureCache.entries[slot];
+    int probes = 0;
+    while (entry->key != 0) {
+        if (entry->key == key && entry->check == check) {
+            // The clock only moves on a miss, so frames that measure the same text don't dirty the mapped pages
+            if (entry->lastUsed != header->clock) entry->lastUsed = header->clock;
+            return (Clay_Dimensions) { entry->width, entry->height };
+        }
+        // A cluster this long only comes from a damaged file, an empty slot would have been found long ago otherwise
+        if (++probes == RAYLIB_MEASURE_CACHE_MAX_PROBES) {
+            return Raylib_MeasureTextUncached(text, config);
+        }
+        slot = (slot + 1) & mask;
+        entry = &Raylib_measureCache.entries[slot];
+    }
+    Clay_Dimensions textSize = Raylib_MeasureTextUncached(text, config);
+    Raylib_MeasureCacheEntry newEntry = { .key = key, .check = check, .width = textSize.width, .height = textSize.height, .lastUsed = ++header->clock };
+    if (header->length < Raylib_MeasureCacheLoadLimit(header->capacity)) {
+        *entry = newEntry;
+        header->length++;
+    } else {
+        // Evicting can move entries of this probe back, so look for the empty slot again
+        Raylib_MeasureCacheEvict(header, Raylib_measureCache.entries);
+        Raylib_MeasureCacheInsert(header, Raylib_measureCache.entries, newEntry);
+    }
+    return textSize;
+}
+
 void Clay_Raylib_Initialize(int width, int height, const char *title, unsigned int flags) {
     SetConfigFlags(flags);
     InitWindow(width, height, title);
@@ -0,0 +1,133 @@
+// Checks that culling offscreen subtrees only drops render commands that couldn't be seen: on a scrolled list, the culled
+// command stream is the uncull stream without the commands outside the screen or the scroll containers clipping them.
+// Elements inside a culled subtree still report their positioned bounding boxes, and a floating element attached inside
+// one is still placed against its parent.
+#include "test.h"
+
+#define ROW_COUNT 100
+#define ROW_HEIGHT 50
+#define SCROLL_Y -2000
+
+static Clay_TextElementConfig textConfig = { .fontSize = 20 };
+
+// A 400x300 list at (50, 50). Row 5 holds Target with Popup floating off it, far enough down to be visible in the list,
+// and row 7 holds a nested scroll container. Both rows are well above the visible part of the list.
+static Clay_RenderCommandArray DeclareList(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .padding = { 50, 50, 50, 50 } })) {
+        CLAY(CLAY_ID("List"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIXED(300) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_SCROLL({ .vertical = true }), CLAY_RECTANGLE({ .color = { 20, 20, 20, 255 } })) {
+            for (int32_t row = 0; row < ROW_COUNT; ++row) {
+                CLAY(CLAY_IDI("Row", row), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(ROW_HEIGHT) }, .padding = { 10, 10, 10, 10 } }), CLAY_RECTANGLE({ .color = { 40, 40, 40, 255 } })) {
+                    CLAY_TEXT(CLAY_STRING("Row"), &textConfig);
+                    if (row == 5) {
+                        CLAY(CLAY_ID("Target"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(100), CLAY_SIZING_FIXED(20) } }), CLAY_RECTANGLE({ .color = { 200, 0, 0, 255 } })) {
+                            CLAY(CLAY_ID("Popup"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_FLOATING({ .offset = { 0, 1850 } }), CLAY_RECTANGLE({ .color = { 0, 200, 0, 255 } })) {}
+                        }
+                    }
+                    if (row == 7) {
+                        CLAY(CLAY_ID("Nested"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(200), CLAY_SIZING_FIXED(30) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_SCROLL({ .vertical = true })) {
+                            for (int32_t item = 0; item < 10; ++item) {
+                                CLAY(CLAY_IDI("NestedItem", item), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(30) } }), CLAY_RECTANGLE({ .color = { 0, 0, 200, 255 } })) {}
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+typedef struct {
+    Clay_RenderCommand *commands;
+    int32_t commandCount;
+    Clay_ElementData target, popup, nested;
+    Clay_ScrollContainerData nestedScroll;
+} Frame;
+
+static Frame LayOutFrame(void) {
+    Clay_RenderCommandArray renderCommands = DeclareList();
+    Frame frame = { .commands = malloc(renderCommands.length * sizeof(Clay_RenderCommand)), .commandCount = renderCommands.length };
+    memcpy(frame.commands, renderCommands.internalArray, renderCommands.length * sizeof(Clay_RenderCommand));
+    frame.target = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("Target")));
+    frame.popup = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("Popup")));
+    frame.nested = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("Nested")));
+    frame.nestedScroll = Clay_GetScrollContainerData(Clay_GetElementId(CLAY_STRING("Nested")));
+    return frame;
+}
+
+// Touching the edge of the visible rect counts as visible, the same as when culling
+static bool Overlaps(Clay_BoundingBox box, Clay_BoundingBox visibleRect) {
+    return visibleRect.width >= 0 && visibleRect.height >= 0 && box.x <= visibleRect.x + visibleRect.width && box.y <= visibleRect.y + visibleRect.height
+        && box.x + box.width >= visibleRect.x && box.y + box.height >= visibleRect.y;
+}
+
+// Drops the commands of the uncull frame that lie outside the screen or the scissor rects around them, scissor commands
+// included, leaving what culling should have produced
+static int32_t FilterVisibleCommands(Frame *frame, Clay_Dimensions screen) {
+    Clay_BoundingBox visibleRects[16] = { { 0, 0, screen.width, screen.height } };
+    bool scissorKept[16];
+    int32_t depth = 0, keptCount = 0;
+    for (int32_t i = 0; i < frame->commandCount; ++i) {
+        Clay_RenderCommand *command = &frame->commands[i];
+        bool keep;
+        if (command->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            keep = Overlaps(command->boundingBox, visibleRects[depth]);
+            scissorKept[++depth] = keep;
+            visibleRects[depth] = Clay__IntersectBoundingBoxes(visibleRects[depth - 1], command->boundingBox);
+        } else if (command->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+            keep = scissorKept[depth--];
+        } else {
+            keep = Overlaps(command->boundingBox, visibleRects[depth]);
+        }
+        if (keep) frame->commands[keptCount++] = *command;
+    }
+    return keptCount;
+}
+
+static void CheckElementDataEqual(Clay_ElementData culled, Clay_ElementData uncull, Clay_BoundingBox expected, const char *name) {
+    CHECK(culled.found && uncull.found, "%s not found", name);
+    CHECK(memcmp(&culled.boundingBox, &uncull.boundingBox, sizeof(Clay_BoundingBox)) == 0, "%s at (%f, %f) when culled, (%f, %f) otherwise",
+        name, culled.boundingBox.x, culled.boundingBox.y, uncull.boundingBox.x, uncull.boundingBox.y);
+    CHECK(memcmp(&culled.boundingBox, &expected, sizeof(Clay_BoundingBox)) == 0, "%s at (%f, %f) %fx%f, expected (%f, %f) %fx%f", name,
+        culled.boundingBox.x, culled.boundingBox.y, culled.boundingBox.width, culled.boundingBox.height, expected.x, expected.y, expected.width, expected.height);
+}
+
+int main(void) {
+    Clay_Dimensions screen = { 800, 600 };
+    Test_Initialize(400, screen);
+    DeclareList();
+    Clay_GetScrollContainerData(Clay_GetElementId(CLAY_STRING("List"))).scrollPosition->y = SCROLL_Y;
+
+    Frame culled = LayOutFrame();
+    Clay_SetCullingEnabled(false);
+    Frame uncull = LayOutFrame();
+    Clay_SetCullingEnabled(true);
+
+    CHECK(culled.commandCount < uncull.commandCount / 4, "%d commands culled, %d without culling", culled.commandCount, uncull.commandCount);
+    int32_t visibleCount = FilterVisibleCommands(&uncull, screen);
+    CHECK(culled.commandCount == visibleCount, "%d commands culled, %d visible without culling", culled.commandCount, visibleCount);
+    for (int32_t i = 0; i < culled.commandCount && i < visibleCount; ++i) {
+        CHECK(Test_RenderCommandsEqual(&culled.commands[i], &uncull.commands[i]), "command %d differs from the visible uncull one", i);
+    }
+
+    // Rows start at the top of the list, moved up by the scroll, and their children sit inside 10 pixels of padding
+    float row5Y = 50 + 5 * ROW_HEIGHT + SCROLL_Y, row7Y = 50 + 7 * ROW_HEIGHT + SCROLL_Y;
+    Clay_BoundingBox target = { 50 + 10 + 3 * 10, row5Y + 10, 100, 20 };
+    CheckElementDataEqual(culled.target, uncull.target, target, "Target");
+    CheckElementDataEqual(culled.popup, uncull.popup, CLAY__INIT(Clay_BoundingBox) { target.x, target.y + 1850, 50, 50 }, "Popup");
+    CheckElementDataEqual(culled.nested, uncull.nested, CLAY__INIT(Clay_BoundingBox) { 50 + 10 + 3 * 10, row7Y + 10, 200, 30 }, "Nested");
+    CHECK(culled.nestedScroll.found && culled.nestedScroll.scrollContainerDimensions.width == 200 && culled.nestedScroll.scrollContainerDimensions.height == 30,
+        "the nested scroll container is %fx%f", culled.nestedScroll.scrollContainerDimensions.width, culled.nestedScroll.scrollContainerDimensions.height);
+    CHECK(culled.nestedScroll.contentDimensions.width == uncull.nestedScroll.contentDimensions.width && culled.nestedScroll.contentDimensions.height == 300,
+        "the nested scroll container's content is %fx%f", culled.nestedScroll.contentDimensions.width, culled.nestedScroll.contentDimensions.height);
+
+    bool popupDrawn = false;
+    for (int32_t i = 0; i < culled.commandCount; ++i) {
+        popupDrawn |= culled.commands[i].id == Clay_GetElementId(CLAY_STRING("Popup")).id;
+    }
+    CHECK(popupDrawn, "the popup floating into view from a culled row wasn't drawn");
+    free(culled.commands);
+    free(uncull.commands);
+    return Test_Finish("culling");
+}
@@ -0,0 +1,191 @@
+// Checks the element hash map through the public declaration API, looking into its slots after every frame:
+//   - every slot in use holds the id of a live item, and every live item is in exactly one slot and can be looked up
+//   - the slots stay in Robin Hood order with no gaps, so an id is never further from its bucket than the one before it was
+//     from its own, by more than one, and the slot before any id that isn't in its own bucket is in use
+//   - removed items are on the free list and nowhere else
+// Ids that stop being declared are swept out a few frames later, and their items reused, without the table filling up.
+#include "test.h"
+
+static uint32_t SlotDistance(uint32_t slotIndex, Clay_ElementIdValue id, uint32_t mask) {
+    return (slotIndex - Clay__LayoutElementHashMapBucket(id, mask)) & mask;
+}
+
+static void CheckHashMap(const char *when) {
+    Clay_Context *context = Clay_GetCurrentContext();
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    Clay__LayoutElementHashMapItemArray *items = &context->layoutElementsHashMapInternal;
+    uint32_t capacity = (uint32_t)context->layoutElementsHashMap.capacity, mask = capacity - 1;
+    CHECK((capacity & mask) == 0, "%s: slot capacity %u isn't a power of two", when, capacity);
+    int32_t *slotCountForItem = (int32_t *)calloc(items->length, sizeof(int32_t));
+    int32_t usedSlotCount = 0;
+    for (uint32_t slotIndex = 0; slotIndex < capacity; ++slotIndex) {
+        Clay__LayoutElementHashMapSlot slot = slots[slotIndex];
+        if (slot.id == 0) {
+            continue;
+        }
+        usedSlotCount++;
+        if (slot.itemIndex < 0 || slot.itemIndex >= items->length) {
+            CHECK(false, "%s: slot %u points at item %d of %d", when, slotIndex, slot.itemIndex, items->length);
+            continue;
+        }
+        slotCountForItem[slot.itemIndex]++;
+        CHECK(items->internalArray[slot.itemIndex].elementId.id == slot.id, "%s: slot %u and its item %d have different ids", when, slotIndex, slot.itemIndex);
+        uint32_t distance = SlotDistance(slotIndex, slot.id, mask);
+        if (distance > 0) {
+            Clay__LayoutElementHashMapSlot previous = slots[(slotIndex - 1) & mask];
+            CHECK(previous.id != 0, "%s: slot %u is %u from its bucket, but the slot before it is empty", when, slotIndex, distance);
+            CHECK(previous.id == 0 || SlotDistance((slotIndex - 1) & mask, previous.id, mask) + 1 >= distance,
+                "%s: slot %u is %u from its bucket, further than the slot before it allows", when, slotIndex, distance);
+        }
+    }
+    int32_t liveItemCount = 0;
+    for (int32_t itemIndex = 0; itemIndex < items->length; ++itemIndex) {
+        Clay_LayoutElementHashMapItem *item = &items->internalArray[itemIndex];
+        if (item->elementId.id == 0) {
+            CHECK(slotCountForItem[itemIndex] == 0, "%s: removed item %d is still in a slot", when, itemIndex);
+            continue;
+        }
+        liveItemCount++;
+        CHECK(slotCountForItem[itemIndex] == 1, "%s: item %d is in %d slots", when, itemIndex, slotCountForItem[itemIndex]);
+        CHECK(Clay__GetHashMapItem(item->elementId.id) == item, "%s: item %d can't be found by its id", when, itemIndex);
+    }
+    CHECK(usedSlotCount == liveItemCount, "%s: %d slots in use for %d live items", when, usedSlotCount, liveItemCount);
+    CHECK(liveItemCount + context->layoutElementsHashMapInternalFreeList.length == items->length,
+        "%s: %d live and %d free items, out of %d", when, liveItemCount, context->layoutElementsHashMapInternalFreeList.length, items->length);
+    for (int32_t i = 0; i < context->layoutElementsHashMapInternalFreeList.length; ++i) {
+        int32_t itemIndex = context->layoutElementsHashMapInternalFreeList.internalArray[i];
+        CHECK(items->internalArray[itemIndex].elementId.id == 0, "%s: item %d is on the free list but still has an id", when, itemIndex);
+    }
+    free(slotCountForItem);
+}
+
+static int32_t LiveItemCount(void) {
+    Clay__LayoutElementHashMapItemArray *items = &Clay_GetCurrentContext()->layoutElementsHashMapInternal;
+    int32_t liveItemCount = 0;
+    for (int32_t i = 0; i < items->length; ++i) {
+        liveItemCount += items->internalArray[i].elementId.id != 0;
+    }
+    return liveItemCount;
+}
+
+static void DeclareItems(const int32_t *indexes, int32_t indexCount) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+        for (int32_t i = 0; i < indexCount; ++i) {
+            CLAY(CLAY_IDI("Item", indexes[i]), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(10), CLAY_SIZING_FIXED(1) } })) {}
+        }
+    }
+    Clay_EndLayout();
+}
+
+static bool ItemDeclared(int32_t index) {
+    return Clay_GetElementData(Clay_GetElementIdWithIndex(CLAY_STRING("Item"), index)).found;
+}
+
+// Finds count ids that land in a few neighbouring buckets: every third one or two buckets along, the rest all in the same
+// one, and those come first. Added in this order, later ids have to displace earlier ones that are closer to their own bucket.
+static void FindClusteredIds(int32_t *clustered, int32_t count) {
+    uint32_t mask = (uint32_t)Clay_GetCurrentContext()->layoutElementsHashMap.capacity - 1;
+    uint32_t targetBucket = Clay__LayoutElementHashMapBucket(Clay_GetElementIdWithIndex(CLAY_STRING("Root"), 0).id, mask) + 40;
+    int32_t clusteredCount = 0;
+    for (int32_t index = 0; clusteredCount < count; ++index) {
+        uint32_t bucket = Clay__LayoutElementHashMapBucket(Clay_GetElementIdWithIndex(CLAY_STRING("Item"), index).id, mask);
+        uint32_t offset = (clusteredCount % 3 == 2) ? 1 + clusteredCount % 2 : 0;
+        if (bucket == ((targetBucket + offset) & mask)) {
+            clustered[clusteredCount++] = index;
+        }
+    }
+}
+
+static void TestClusteredIds(void) {
+    Test_Initialize(256, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    int32_t clustered[48];
+    FindClusteredIds(clustered, 48);
+    for (int32_t frame = 0; frame < 4; ++frame) {
+        DeclareItems(clustered, 48);
+        CheckHashMap("clustered ids");
+    }
+    for (int32_t i = 0; i < 48; ++i) {
+        CHECK(ItemDeclared(clustered[i]), "clustered id %d isn't found", i);
+        CHECK(!Clay_GetElementData(Clay_GetElementIdWithIndex(CLAY_STRING("Missing"), i)).found, "an id that was never declared is found");
+    }
+}
+
+// Enough ids to fill half the slots, the most the map is ever asked to hold
+static void TestManyIds(void) {
+    const int32_t idCount = 4000;
+    Test_Initialize(idCount + 100, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    int32_t *indexes = (int32_t *)malloc(sizeof(int32_t) * idCount);
+    for (int32_t i = 0; i < idCount; ++i) {
+        indexes[i] = i * 7919;
+    }
+    DeclareItems(indexes, idCount);
+    CheckHashMap("many ids");
+    int32_t missingCount = 0;
+    for (int32_t i = 0; i < idCount; ++i) {
+        missingCount += !ItemDeclared(indexes[i]);
+    }
+    CHECK(missingCount == 0, "%d of %d ids weren't found", missingCount, idCount);
+    free(indexes);
+}
+
+// Every other id in the cluster stops being declared. Once the sweep has taken them out, the ids after them have had to shift
+// back, and adding them again puts them into the gaps that left, on items from the free list.
+static void TestRemovedClusteredIds(void) {
+    Test_Initialize(256, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    int32_t clustered[48], kept[24];
+    FindClusteredIds(clustered, 48);
+    DeclareItems(clustered, 48);
+    // The root container and Root are in the map too
+    int32_t otherItemCount = LiveItemCount() - 48;
+    int32_t itemCount = Clay_GetCurrentContext()->layoutElementsHashMapInternal.length;
+    for (int32_t i = 0; i < 24; ++i) {
+        kept[i] = clustered[i * 2 + 1];
+    }
+    for (int32_t frame = 0; frame < 128; ++frame) {
+        DeclareItems(kept, 24);
+        CheckHashMap("clustered ids removed");
+    }
+    CHECK(LiveItemCount() == 24 + otherItemCount, "%d items still live, expected %d", LiveItemCount(), 24 + otherItemCount);
+    for (int32_t i = 0; i < 48; ++i) {
+        CHECK(ItemDeclared(clustered[i]) == (i % 2 == 1), "clustered id %d is %s", i, i % 2 == 1 ? "missing" : "still there");
+    }
+    DeclareItems(clustered, 48);
+    CheckHashMap("clustered ids added back");
+    for (int32_t i = 0; i < 48; ++i) {
+        CHECK(ItemDeclared(clustered[i]), "clustered id %d isn't found after being added back", i);
+    }
+    CHECK(Clay_GetCurrentContext()->layoutElementsHashMapInternal.length == itemCount, "the ids added back took new items instead of the freed ones");
+}
+
+// A whole new set of ids every frame, with room in the map for only a few frames' worth. Without the sweep reclaiming the
+// stale items the map would fill up in four frames.
+static void TestChurningIds(void) {
+    const int32_t idsPerFrame = 500;
+    Test_Initialize(idsPerFrame * 4 + 100, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    int32_t *indexes = (int32_t *)malloc(sizeof(int32_t) * idsPerFrame);
+    for (int32_t frame = 0; frame < 64; ++frame) {
+        for (int32_t i = 0; i < idsPerFrame; ++i) {
+            indexes[i] = frame * idsPerFrame + i;
+        }
+        DeclareItems(indexes, idsPerFrame);
+        CheckHashMap("churning ids");
+        int32_t missingCount = 0;
+        for (int32_t i = 0; i < idsPerFrame; ++i) {
+            missingCount += !ItemDeclared(indexes[i]);
+        }
+        CHECK(missingCount == 0, "frame %d: %d of the ids declared this frame weren't found", frame, missingCount);
+        if (frame >= 8) {
+            CHECK(!ItemDeclared((frame - 8) * idsPerFrame), "frame %d: an id from eight frames ago is still there", frame);
+        }
+    }
+    free(indexes);
+}
+
+int main(void) {
+    TestClusteredIds();
+    TestManyIds();
+    TestRemovedClusteredIds();
+    TestChurningIds();
+    return Test_Finish("element_hash_map");
+}
@@ -0,0 +1,117 @@
+// Checks element ids in the default 32 bit mode and with CLAY_64BIT_IDS, which the Makefile builds this as well:
+//   - 32 bit: two strings of different lengths that hash to the same id are counted as a collision. The second gets a fresh
+//     item across frames, and declaring both in one frame is reported as a duplicate id. Two strings of the same length can
+//     only be told apart within a frame, which the duplicate id check already covers.
+//   - 64 bit: the same number of strings don't collide at all, the high half of the id is used, and Clay__Rehash gives the
+//     same id as hashing the string again.
+#include "test.h"
+
+#define LABEL_COUNT 400000
+
+static char labels[LABEL_COUNT][16];
+
+static Clay_String Label(int32_t index) {
+    return CLAY__INIT(Clay_String) { .length = (int32_t)strlen(labels[index]), .chars = labels[index] };
+}
+
+typedef struct {
+    Clay_ElementIdValue id;
+    int32_t labelIndex;
+} LabelId;
+
+static int CompareLabelIds(const void *a, const void *b) {
+    Clay_ElementIdValue idA = ((const LabelId *)a)->id, idB = ((const LabelId *)b)->id;
+    return idA < idB ? -1 : idA > idB;
+}
+
+// Sorts every label's id, so that the ones that collide end up next to each other
+static LabelId *SortedLabelIds(void) {
+    LabelId *labelIds = (LabelId *)malloc(sizeof(LabelId) * LABEL_COUNT);
+    for (int32_t i = 0; i < LABEL_COUNT; ++i) {
+        labelIds[i] = CLAY__INIT(LabelId) { Clay__HashString(Label(i), 0, 0).id, i };
+    }
+    qsort(labelIds, LABEL_COUNT, sizeof(LabelId), CompareLabelIds);
+    return labelIds;
+}
+
+static void DeclareLabels(const int32_t *labelIndexes, int32_t labelCount) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+        for (int32_t i = 0; i < labelCount; ++i) {
+            CLAY(Clay__AttachId(Clay__HashString(Label(labelIndexes[i]), 0, 0)), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(10), CLAY_SIZING_FIXED(1) } })) {}
+        }
+    }
+    Clay_EndLayout();
+}
+
+#ifndef CLAY_64BIT_IDS
+static void TestCollidingIds(void) {
+    LabelId *labelIds = SortedLabelIds();
+    int32_t pair[2] = { -1, -1 };
+    for (int32_t i = 1; i < LABEL_COUNT && pair[0] < 0; ++i) {
+        if (labelIds[i].id == labelIds[i - 1].id && Label(labelIds[i].labelIndex).length != Label(labelIds[i - 1].labelIndex).length) {
+            pair[0] = labelIds[i - 1].labelIndex;
+            pair[1] = labelIds[i].labelIndex;
+        }
+    }
+    free(labelIds);
+    CHECK(pair[0] >= 0, "no two of %d labels with different lengths share a 32 bit id", LABEL_COUNT);
+    if (pair[0] < 0) {
+        return;
+    }
+    Test_Initialize(100, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    Clay_ElementId first = Clay__HashString(Label(pair[0]), 0, 0), second = Clay__HashString(Label(pair[1]), 0, 0);
+    DeclareLabels(&pair[0], 1);
+    CHECK(Clay_GetElementIdCollisionCount() == 0, "a collision was counted before the second label was declared");
+    // The second label replaces the first on a later frame, and starts over instead of taking on the first one's item
+    DeclareLabels(&pair[1], 1);
+    CHECK(Clay_GetElementIdCollisionCount() == 1, "%u collisions counted, expected 1", Clay_GetElementIdCollisionCount());
+    Clay_LayoutElementHashMapItem *hashItem = Clay__GetHashMapItem(second.id);
+    CHECK(hashItem->elementId.stringId.length == second.stringId.length && hashItem->elementId.stringId.length != first.stringId.length, "the hash map item still belongs to the first label");
+    // Both in the same frame is a duplicate id, which clay reports. The first label collides with the second's item from the
+    // last frame, then the second with the first's from this one.
+    DeclareLabels(pair, 2);
+    CHECK(Clay_GetElementIdCollisionCount() == 3, "%u collisions counted, expected 3", Clay_GetElementIdCollisionCount());
+    CHECK(Test_errorCount == 1, "%d errors reported for two labels with the same id in one frame, expected 1", Test_errorCount);
+    Test_errorCount = 0;
+}
+#else
+static void TestDistinctIds(void) {
+    LabelId *labelIds = SortedLabelIds();
+    int32_t sharedCount = 0;
+    for (int32_t i = 1; i < LABEL_COUNT; ++i) {
+        sharedCount += labelIds[i].id == labelIds[i - 1].id;
+    }
+    CHECK(sharedCount == 0, "%d of %d labels share a 64 bit id", sharedCount, LABEL_COUNT);
+    CHECK(labelIds[LABEL_COUNT - 1].id > UINT32_MAX, "no id uses the high half");
+    free(labelIds);
+    for (uint32_t offset = 0; offset < 1000; ++offset) {
+        Clay_ElementId hashed = Clay__HashString(CLAY_STRING("Item"), offset, 0);
+        CHECK(Clay__Rehash(Clay__HashString(CLAY_STRING("Item"), 0, 0), offset).id == hashed.id, "rehashing with offset %u gives a different id", offset);
+    }
+    // Declared all at once, none of them are taken for one another
+    const int32_t declaredCount = 50000;
+    Test_Initialize(declaredCount + 100, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    int32_t *labelIndexes = (int32_t *)malloc(sizeof(int32_t) * declaredCount);
+    for (int32_t i = 0; i < declaredCount; ++i) {
+        labelIndexes[i] = i;
+    }
+    DeclareLabels(labelIndexes, declaredCount);
+    CHECK(Clay_GetElementIdCollisionCount() == 0, "%u collisions counted", Clay_GetElementIdCollisionCount());
+    free(labelIndexes);
+}
+#endif
+
+int main(void) {
+    for (int32_t i = 0; i < LABEL_COUNT; ++i) {
+        // Three prefixes of different lengths, so that some of the ids that collide come from labels of different lengths
+        snprintf(labels[i], sizeof(labels[i]), "%s%d", i % 3 == 0 ? "A" : i % 3 == 1 ? "BB" : "CCC", i / 3);
+    }
+#ifndef CLAY_64BIT_IDS
+    TestCollidingIds();
+    return Test_Finish("element_ids");
+#else
+    TestDistinctIds();
+    return Test_Finish("element_ids_64bit_ids");
+#endif
+}
@@ -0,0 +1,63 @@
+// Checks that when only scroll positions, colors or the pointer change between frames, and every element takes the size it
+// had in the previous frame without going through the sizing passes, the layout is the same as one done from scratch. Also
+// checks a frame where one text changes, which has to be sized again.
+#include "test.h"
+
+static Clay_Color buttonColor = { 80, 80, 80, 255 };
+static Clay_Vector2 pointerPosition = { -1, -1 };
+static char statusText[32] = "Ready";
+static Clay_TextElementConfig textConfig = { .fontSize = 16 };
+
+static Clay_RenderCommandArray LayOutFrame(void) {
+    Clay_SetPointerState(pointerPosition, false);
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .padding = { 8, 8, 8, 8 }, .childGap = 8 })) {
+        CLAY(CLAY_ID("Sidebar"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(200), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 }), CLAY_BORDER({ .betweenChildren = { 1, { 255, 255, 255, 255 } } })) {
+            for (int32_t i = 0; i < 5; ++i) {
+                CLAY(CLAY_IDI("Button", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = { 8, 8, 4, 4 } })) {
+                    Clay_Color color = Clay_Hovered() ? CLAY__INIT(Clay_Color) { 120, 120, 200, 255 } : buttonColor;
+                    CLAY(CLAY_RECTANGLE({ .color = color }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(24) } })) {}
+                    if (i == 2) {
+                        CLAY(CLAY_ID("Tooltip"), CLAY_FLOATING({ .offset = { 210, 0 } }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) } }), CLAY_RECTANGLE({ .color = buttonColor })) {
+                            CLAY_TEXT(CLAY_STRING("Floats next to the button, as wide as it"), &textConfig);
+                        }
+                    }
+                }
+            }
+        }
+        CLAY(CLAY_ID("Main"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 8 })) {
+            CLAY_TEXT(CLAY_STRING("A paragraph long enough to wrap over several lines in the main area of the layout, so that wrapped text goes through the restored sizes too."), &textConfig);
+            CLAY(CLAY_ID("List"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_PERCENT(0.5f), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_SCROLL({ .vertical = true })) {
+                for (int32_t i = 0; i < 30; ++i) {
+                    CLAY(CLAY_IDI("Item", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = { 4, 4, 4, 4 } }), CLAY_RECTANGLE({ .color = buttonColor })) {
+                        CLAY_TEXT(CLAY_STRING("List item"), &textConfig);
+                    }
+                }
+            }
+            Clay_String status = { .length = (int32_t)strlen(statusText), .chars = statusText };
+            CLAY_TEXT(status, &textConfig);
+        }
+    }
+    return Clay_EndLayout();
+}
+
+int main(void) {
+    Test_Initialize(400, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    Test_CheckMatchesFreshLayout(LayOutFrame, "first frame");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "nothing changed");
+
+    Clay_GetScrollContainerData(Clay_GetElementId(CLAY_STRING("List"))).scrollPosition->y = -120;
+    Test_CheckMatchesFreshLayout(LayOutFrame, "scrolled");
+
+    buttonColor = CLAY__INIT(Clay_Color) { 200, 60, 60, 255 };
+    Test_CheckMatchesFreshLayout(LayOutFrame, "color changed");
+
+    Clay_BoundingBox button = Clay_GetElementData(Clay_GetElementIdWithIndex(CLAY_STRING("Button"), 2)).boundingBox;
+    pointerPosition = CLAY__INIT(Clay_Vector2) { button.x + 10, button.y + 10 };
+    Test_CheckMatchesFreshLayout(LayOutFrame, "pointer over a button");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "button hovered");
+
+    snprintf(statusText, sizeof(statusText), "Saved 3 files");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "status text changed");
+    return Test_Finish("layout_unchanged");
+}
@@ -0,0 +1,90 @@
+// Checks the persistent measure text cache in the raylib renderer once its table is full: new text still gets cached by
+// evicting older entries, and reopening the file rebuilds it with room to spare, keeping the most recently used entries, or
+// grows it when a larger capacity is asked for.
+#include "test.h"
+#include "clay_renderer_raylib.c"
+
+static const char *cachePath = "build/measure_text_cache.bin";
+static GlyphInfo glyphs[95];
+static Rectangle glyphRectangles[95];
+static char textBuffer[64];
+
+static Clay_StringSlice Text(const char *prefix, int32_t index) {
+    int32_t length = snprintf(textBuffer, sizeof(textBuffer), "%s %d", prefix, index);
+    return CLAY__INIT(Clay_StringSlice) { .length = length, .chars = textBuffer, .baseChars = textBuffer };
+}
+
+static Clay_TextElementConfig textConfig = { .fontId = 0, .fontSize = 24 };
+
+// Probes for the text the way a lookup does, so evictions that leave an entry out of reach of its home slot show up too
+static bool Cached(Clay_StringSlice text) {
+    uint64_t key = Raylib_MeasureCacheKey(text, &textConfig), check = Raylib_MeasureCacheCheck(text, &textConfig);
+    uint32_t mask = Raylib_measureCache.header->capacity - 1;
+    for (uint32_t slot = (uint32_t)key & mask; Raylib_measureCache.entries[slot].key != 0; slot = (slot + 1) & mask) {
+        if (Raylib_measureCache.entries[slot].key == key && Raylib_measureCache.entries[slot].check == check) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Measures the texts through the cache, checking the widths it gives against measuring them directly
+static void MeasureTexts(const char *prefix, int32_t count) {
+    for (int32_t i = 0; i < count; ++i) {
+        Clay_StringSlice text = Text(prefix, i);
+        float width = Raylib_MeasureText(text, &textConfig, 0).width;
+        CHECK(width == Raylib_MeasureTextUncached(text, &textConfig).width, "\"%s %d\" measured %f wide through the cache", prefix, i, width);
+    }
+}
+
+static int32_t CachedCount(const char *prefix, int32_t first, int32_t count) {
+    int32_t cachedCount = 0;
+    for (int32_t i = first; i < first + count; ++i) {
+        cachedCount += Cached(Text(prefix, i));
+    }
+    return cachedCount;
+}
+
+int main(void) {
+    for (int32_t i = 0; i < 95; ++i) {
+        glyphs[i].advanceX = 10 + i % 7;
+    }
+    Raylib_fonts[0] = CLAY__INIT(Raylib_Font) { .fontId = 0, .font = { .baseSize = 48, .glyphCount = 95, .recs = glyphRectangles, .glyphs = glyphs }, .fileHash = 1234 };
+    remove(cachePath);
+
+    // 64 slots fill up at 48 entries, and everything measured after that has to evict an older entry
+    CHECK(Raylib_OpenMeasureTextCache(cachePath, 64), "couldn't create %s", cachePath);
+    MeasureTexts("first", 200);
+    CHECK(Raylib_measureCache.header->length == 48, "%u entries in a 64 slot table, expected it to stop at 48", Raylib_measureCache.header->length);
+    MeasureTexts("second", 40);
+    int32_t replacedCount = CachedCount("second", 0, 40);
+    CHECK(replacedCount == 40, "only %d of 40 texts measured once the table was full were cached", replacedCount);
+    CHECK(Raylib_measureCache.header->length == 48, "replacing entries changed the length to %u", Raylib_measureCache.header->length);
+    Raylib_CloseMeasureTextCache();
+
+    // A full table is rebuilt on open, half full with the most recently used entries, and takes new text again
+    CHECK(Raylib_OpenMeasureTextCache(cachePath, 64), "couldn't reopen %s", cachePath);
+    CHECK(Raylib_measureCache.header->capacity == 64 && Raylib_measureCache.header->length <= 32, "reopened with %u of %u slots in use", Raylib_measureCache.header->length, Raylib_measureCache.header->capacity);
+    CHECK(CachedCount("second", 0, 40) == 32 && CachedCount("first", 0, 200) == 0, "the rebuild didn't keep the most recently used entries");
+    uint32_t lengthBefore = Raylib_measureCache.header->length;
+    MeasureTexts("third", 10);
+    CHECK(Raylib_measureCache.header->length == lengthBefore + 10, "%u entries after adding 10 to %u", Raylib_measureCache.header->length, lengthBefore);
+    CHECK(CachedCount("third", 0, 10) == 10, "new text wasn't cached after the rebuild");
+    Raylib_CloseMeasureTextCache();
+
+    // Asking for more room grows the table, keeping what's in it
+    CHECK(Raylib_OpenMeasureTextCache(cachePath, 256), "couldn't reopen %s", cachePath);
+    CHECK(Raylib_measureCache.header->capacity == 256, "capacity %u after asking for 256", Raylib_measureCache.header->capacity);
+    CHECK(Raylib_measureCache.header->length == lengthBefore + 10, "growing the table left %u of %u entries", Raylib_measureCache.header->length, lengthBefore + 10);
+    CHECK(CachedCount("third", 0, 10) == 10, "growing the table dropped entries");
+    MeasureTexts("third", 10);
+    MeasureTexts("second", 40);
+    Raylib_CloseMeasureTextCache();
+
+    // A smaller capacity than the file's doesn't shrink it
+    CHECK(Raylib_OpenMeasureTextCache(cachePath, 64), "couldn't reopen %s", cachePath);
+    CHECK(Raylib_measureCache.header->capacity == 256, "capacity %u after asking for less than the file has", Raylib_measureCache.header->capacity);
+    Raylib_CloseMeasureTextCache();
+    remove(cachePath);
+    return Test_Finish("measure_text_cache");
+}
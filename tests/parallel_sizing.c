@@ -0,0 +1,80 @@
+// Checks that sizing a large layout through Clay_SetLayoutParallelFunction gives exactly the same element sizes and render
+// commands as sizing it serially, both from scratch and when most subtrees are reused from the previous frame.
+#include "test.h"
+
+#define CARD_COUNT 400
+
+static int32_t parallelForCallCount = 0;
+static int32_t parallelTaskCount = 0;
+static char titleText[32] = "Card title";
+static Clay_TextElementConfig textConfig = { .fontSize = 16 };
+static Clay_TextElementConfig wrappedTextConfig = { .fontSize = 12, .wrapMode = CLAY_TEXT_WRAP_WORDS };
+
+// Runs the tasks last to first, so that nothing can depend on them running in order
+static void ReverseParallelFor(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, uintptr_t userData) {
+    parallelForCallCount++;
+    parallelTaskCount += taskCount;
+    for (int32_t i = taskCount - 1; i >= 0; --i) {
+        task(i, taskData);
+    }
+}
+
+// A wrapping grid of cards in a scroll container, with a tooltip that grows to the size of one of them
+static Clay_RenderCommandArray LayOutFrame(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+        CLAY(CLAY_ID("Grid"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 }), CLAY_SCROLL({ .vertical = true })) {
+            for (int32_t row = 0; row < CARD_COUNT / 4; ++row) {
+                CLAY(CLAY_IDI("GridRow", row), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .childGap = 4 })) {
+                    for (int32_t column = 0; column < 4; ++column) {
+                        int32_t card = row * 4 + column;
+                        Clay_SizingAxis width = column == 0 ? CLAY_SIZING_PERCENT(0.3f) : column == 1 ? CLAY_SIZING_FIT(0) : CLAY_SIZING_GROW(0);
+                        CLAY(CLAY_IDI("Card", card), CLAY_LAYOUT({ .sizing = { width, CLAY_SIZING_FIT(0) }, .padding = { 6, 6, 6, 6 }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 2 }), CLAY_RECTANGLE({ .color = { 60, 60, 60, 255 } })) {
+                            Clay_String title = { .length = (int32_t)strlen(titleText), .chars = titleText };
+                            CLAY_TEXT(card == 123 ? title : CLAY_STRING("Card title"), &textConfig);
+                            CLAY_TEXT(CLAY_STRING("Some description text that wraps inside the card when it is narrow enough"), &wrappedTextConfig);
+                            CLAY(CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(8) } }), CLAY_RECTANGLE({ .color = { 120, 120, 120, 255 } })) {}
+                            if (card == 200) {
+                                CLAY(CLAY_ID("Tooltip"), CLAY_FLOATING({ .offset = { 0, 40 } }), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } }), CLAY_RECTANGLE({ .color = { 0, 0, 0, 255 } })) {
+                                    CLAY_TEXT(CLAY_STRING("As big as its card"), &wrappedTextConfig);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+// Lays the frame out in parallel, from scratch unless reuse is set, and then serially from scratch, and compares them
+static void CheckParallelMatchesSerial(bool reuse, const char *when) {
+    Clay_SetLayoutParallelFunction(ReverseParallelFor, 0);
+    if (!reuse) {
+        Test_ForgetPreviousLayout();
+    }
+    int32_t callCountBefore = parallelForCallCount;
+    Test_Layout parallel = Test_CopyLayout(LayOutFrame());
+    CHECK(parallelForCallCount > callCountBefore, "%s: sizing wasn't split into tasks", when);
+    Clay_SetLayoutParallelFunction(NULL, 0);
+    Test_ForgetPreviousLayout();
+    Test_CheckLayoutEqual(&parallel, LayOutFrame(), when);
+    Test_FreeLayout(&parallel);
+}
+
+int main(void) {
+    Test_Initialize(CARD_COUNT * 8 + 400, CLAY__INIT(Clay_Dimensions) { 1200, 800 });
+    CheckParallelMatchesSerial(false, "from scratch");
+
+    snprintf(titleText, sizeof(titleText), "A much longer card title");
+    CheckParallelMatchesSerial(false, "title changed, from scratch");
+    // Only the row with the changed card is sized again, the rest is reused from the serial layout just before
+    snprintf(titleText, sizeof(titleText), "Short");
+    CheckParallelMatchesSerial(true, "title changed, reusing the rest");
+
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 700, 800 });
+    CheckParallelMatchesSerial(false, "narrower window");
+    CHECK(parallelTaskCount > parallelForCallCount, "only one task per call");
+    return Test_Finish("parallel_sizing");
+}
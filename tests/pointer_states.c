@@ -0,0 +1,54 @@
+// Checks Clay_SetPointerStates against Clay_SetPointerState, and that calling it again after its id buffer was too small
+// doesn't advance the pointers' states a second time, which would lose a press or release made that frame.
+#include "test.h"
+
+static void DeclareNestedBoxes(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Outer"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIXED(400) }, .padding = { 20, 20 } })) {
+        CLAY(CLAY_ID("Middle"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .padding = { 20, 20 } })) {
+            CLAY(CLAY_ID("Inner"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } })) {}
+        }
+    }
+    Clay_EndLayout();
+}
+
+// The ids Clay_SetPointerState finds the single pointer over
+static void CheckIdsMatchSinglePointer(Clay_PointerBatchItem *pointer, Clay_ElementId *pointerOverIds, const char *when) {
+    Clay_SetPointerState(pointer->position, pointer->pointerDown);
+    Clay__ElementIdArray *expected = &Clay_GetCurrentContext()->pointerOverIds;
+    CHECK(pointer->pointerOverIdsLength == expected->length, "%s: %d ids, Clay_SetPointerState found %d", when, pointer->pointerOverIdsLength, expected->length);
+    for (int32_t i = 0; i < pointer->pointerOverIdsLength && i < expected->length; ++i) {
+        CHECK(pointerOverIds[pointer->pointerOverIdsOffset + i].id == expected->internalArray[i].id, "%s: id %d differs from Clay_SetPointerState's", when, i);
+    }
+}
+
+// Calls with room for only one id, then again with enough, and checks the state the pointer ends up in
+static void SetPointerStateWithRetry(Clay_PointerBatchItem *pointer, bool pointerDown, Clay_PointerDataInteractionState expectedState, const char *when) {
+    Clay_ElementId pointerOverIds[16];
+    pointer->pointerDown = pointerDown;
+    Clay_PointerDataInteractionState stateBefore = pointer->state;
+    int32_t idCount = Clay_SetPointerStates(pointer, 1, pointerOverIds, 1);
+    CHECK(idCount == 4, "%s: %d ids found, expected the root and three boxes", when, idCount);
+    CHECK(pointer->pointerOverIdsLength == 1, "%s: %d ids written to room for one", when, pointer->pointerOverIdsLength);
+    CHECK(pointer->state == stateBefore, "%s: the state was advanced although the ids didn't fit", when);
+    idCount = Clay_SetPointerStates(pointer, 1, pointerOverIds, 16);
+    CHECK(idCount == 4 && pointer->pointerOverIdsLength == 4, "%s: %d ids found and %d written on the retry", when, idCount, pointer->pointerOverIdsLength);
+    CHECK(pointer->state == expectedState, "%s: state %d after the retry, expected %d", when, pointer->state, expectedState);
+    CheckIdsMatchSinglePointer(pointer, pointerOverIds, when);
+}
+
+int main(void) {
+    Test_Initialize(100, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    DeclareNestedBoxes();
+    Clay_PointerBatchItem pointer = { .position = { 200, 200 }, .state = CLAY_POINTER_DATA_RELEASED };
+    SetPointerStateWithRetry(&pointer, true, CLAY_POINTER_DATA_PRESSED_THIS_FRAME, "press");
+    SetPointerStateWithRetry(&pointer, true, CLAY_POINTER_DATA_PRESSED, "held");
+    SetPointerStateWithRetry(&pointer, false, CLAY_POINTER_DATA_RELEASED_THIS_FRAME, "release");
+    SetPointerStateWithRetry(&pointer, false, CLAY_POINTER_DATA_RELEASED, "released");
+    // With enough room the first time, the state advances straight away
+    Clay_ElementId pointerOverIds[16];
+    pointer.pointerDown = true;
+    Clay_SetPointerStates(&pointer, 1, pointerOverIds, 16);
+    CHECK(pointer.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME, "state %d after a press with enough room", pointer.state);
+    return Test_Finish("pointer_states");
+}
@@ -0,0 +1,21 @@
+// Empty stand-ins for the raylib functions clay_renderer_raylib.c calls, so that its text measurement can be tested without
+// linking raylib. None of them are called by the tests.
+#include <stddef.h>
+#include "raylib.h"
+
+void BeginMode3D(Camera3D camera) {}
+void BeginScissorMode(int x, int y, int width, int height) {}
+void DrawModel(Model model, Vector3 position, float scale, Color tint) {}
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {}
+void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) {}
+void DrawRing(Vector2 center, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, Color color) {}
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {}
+void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) {}
+void EndMode3D(void) {}
+void EndScissorMode(void) {}
+const char *GetFileExtension(const char *fileName) { return NULL; }
+void InitWindow(int width, int height, const char *title) {}
+unsigned char *LoadFileData(const char *fileName, int *dataSize) { return NULL; }
+Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int fontSize, int *codepoints, int codepointCount) { Font font = { 0 }; return font; }
+void SetConfigFlags(unsigned int flags) {}
+void UnloadFileData(unsigned char *data) {}
@@ -0,0 +1,66 @@
+// Checks that when one leaf changes its text or sizing, the subtrees around it that keep their previous sizes come out the
+// same as a layout done from scratch, including the ones whose parent had to be sized again because of the change.
+#include "test.h"
+
+static char cellTexts[3][4][32];
+static float leafWidth = 60;
+static Clay_SizingAxis panelWidths[3];
+static Clay_TextElementConfig textConfig = { .fontSize = 16 };
+static Clay_TextElementConfig wrappedTextConfig = { .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_WORDS };
+
+static Clay_RenderCommandArray LayOutFrame(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .padding = { 8, 8, 8, 8 }, .childGap = 8 })) {
+        for (int32_t panel = 0; panel < 3; ++panel) {
+            CLAY(CLAY_IDI("Panel", panel), CLAY_LAYOUT({ .sizing = { panelWidths[panel], CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 }), CLAY_RECTANGLE({ .color = { 40, 40, 40, 255 } })) {
+                for (int32_t row = 0; row < 4; ++row) {
+                    CLAY(CLAY_IDI_LOCAL("Row", row), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = { 4, 4, 4, 4 }, .childGap = 4 })) {
+                        Clay_String text = { .length = (int32_t)strlen(cellTexts[panel][row]), .chars = cellTexts[panel][row] };
+                        CLAY_TEXT(text, row == 3 ? &wrappedTextConfig : &textConfig);
+                        CLAY(CLAY_ID_LOCAL("Fill"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(20) } }), CLAY_RECTANGLE({ .color = { 90, 90, 90, 255 } })) {}
+                        if (panel == 1 && row == 1) {
+                            CLAY(CLAY_ID("Leaf"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(leafWidth), CLAY_SIZING_FIXED(20) } }), CLAY_RECTANGLE({ .color = { 200, 90, 90, 255 } })) {}
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+int main(void) {
+    for (int32_t panel = 0; panel < 3; ++panel) {
+        for (int32_t row = 0; row < 4; ++row) {
+            snprintf(cellTexts[panel][row], sizeof(cellTexts[panel][row]), row == 3 ? "Wrapped words in panel %d" : "Cell %d %d", panel, row);
+        }
+    }
+    panelWidths[0] = CLAY_SIZING_FIXED(220);
+    panelWidths[1] = CLAY_SIZING_FIT(0);
+    panelWidths[2] = CLAY_SIZING_GROW(0);
+    Test_Initialize(200, CLAY__INIT(Clay_Dimensions) { 800, 600 });
+    Test_CheckMatchesFreshLayout(LayOutFrame, "first frame");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "nothing changed");
+
+    // Inside a fixed width panel, so only that row is sized again
+    snprintf(cellTexts[0][1], sizeof(cellTexts[0][1]), "Longer cell text");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "text in a fixed panel changed");
+
+    // The fit panel grows, and the grow panel next to it has to shrink
+    leafWidth = 140;
+    Test_CheckMatchesFreshLayout(LayOutFrame, "leaf in a fit panel widened");
+    snprintf(cellTexts[1][2], sizeof(cellTexts[1][2]), "A");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "text in a fit panel shortened");
+
+    // Wrapped text in the grow panel changes height, which moves the rows under it but not their widths
+    snprintf(cellTexts[2][3], sizeof(cellTexts[2][3]), "Many more wrapped words that now need another line or two in panel 2");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "wrapped text in a grow panel changed");
+
+    panelWidths[0] = CLAY_SIZING_FIXED(180);
+    Test_CheckMatchesFreshLayout(LayOutFrame, "panel sizing changed");
+
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 700, 500 });
+    Test_CheckMatchesFreshLayout(LayOutFrame, "window resized");
+    Test_CheckMatchesFreshLayout(LayOutFrame, "nothing changed after the resize");
+    return Test_Finish("subtree_reuse");
+}
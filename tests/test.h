@@ -0,0 +1,112 @@
+// Shared setup for the tests. Each test is a single translation unit that includes clay.h with CLAY_IMPLEMENTATION, and
+// returns Test_Finish() from main, which fails the run if any CHECK failed or clay reported an error.
+#define CLAY_IMPLEMENTATION
+#include "clay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int Test_failureCount = 0;
+static int Test_errorCount = 0;
+static void *Test_arenaMemory = NULL;
+
+#define CHECK(condition, ...) do { if (!(condition)) { Test_failureCount++; fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); } } while (0)
+
+// Monospaced, so that the layout doesn't depend on anything outside of clay.h
+static Clay_Dimensions Test_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, uintptr_t userData) {
+    return CLAY__INIT(Clay_Dimensions) { (float)text.length * config->fontSize * 0.5f, (float)config->fontSize };
+}
+
+static void Test_HandleError(Clay_ErrorData errorData) {
+    Test_errorCount++;
+    fprintf(stderr, "clay error: %.*s\n", errorData.errorText.length, errorData.errorText.chars);
+}
+
+// Each test starts from a new context, sized for it
+static void Test_Initialize(int32_t maxElementCount, Clay_Dimensions layoutDimensions) {
+    Clay_SetCurrentContext(NULL);
+    Clay_SetMaxElementCount(maxElementCount);
+    uint64_t memorySize = Clay_MinMemorySize();
+    free(Test_arenaMemory);
+    Test_arenaMemory = malloc(memorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(memorySize, Test_arenaMemory), layoutDimensions, CLAY__INIT(Clay_ErrorHandler) { Test_HandleError });
+    Clay_SetMeasureTextFunction(Test_MeasureText, 0);
+}
+
+// Compares every field, bounding boxes bit for bit. Comparing whole commands would also compare their padding, which text
+// commands leave uninitialised.
+static bool Test_RenderCommandsEqual(Clay_RenderCommand *a, Clay_RenderCommand *b) {
+    return memcmp(&a->boundingBox, &b->boundingBox, sizeof(Clay_BoundingBox)) == 0 && a->config.rectangleElementConfig == b->config.rectangleElementConfig
+        && a->text.length == b->text.length && a->text.chars == b->text.chars && a->text.baseChars == b->text.baseChars
+        && a->zIndex == b->zIndex && a->id == b->id && a->commandType == b->commandType;
+}
+
+// Makes the next layout size every element from scratch. Only sizes from the frame just before can be reused, so this
+// doesn't rely on the fingerprints that decide what changed.
+static void Test_ForgetPreviousLayout(void) {
+    Clay_Context *context = Clay_GetCurrentContext();
+    for (int32_t i = 0; i < context->layoutElementsHashMapInternal.length; ++i) {
+        context->layoutElementsHashMapInternal.internalArray[i].layoutGeneration = context->generation + 2;
+    }
+}
+
+// The element sizes and render commands of a layout, copied out of the context
+typedef struct {
+    Clay_Dimensions *dimensions;
+    int32_t elementCount;
+    Clay_RenderCommand *commands;
+    int32_t commandCount;
+} Test_Layout;
+
+static Test_Layout Test_CopyLayout(Clay_RenderCommandArray renderCommands) {
+    Clay_Context *context = Clay_GetCurrentContext();
+    Test_Layout layout = { .elementCount = context->layoutElements.length, .commandCount = renderCommands.length };
+    layout.dimensions = malloc(layout.elementCount * sizeof(Clay_Dimensions));
+    layout.commands = malloc(layout.commandCount * sizeof(Clay_RenderCommand));
+    for (int32_t i = 0; i < layout.elementCount; ++i) {
+        layout.dimensions[i] = context->layoutElements.internalArray[i].dimensions;
+    }
+    memcpy(layout.commands, renderCommands.internalArray, layout.commandCount * sizeof(Clay_RenderCommand));
+    return layout;
+}
+
+static void Test_FreeLayout(Test_Layout *layout) {
+    free(layout->dimensions);
+    free(layout->commands);
+}
+
+// Checks the layout just done against another one, element sizes bit for bit
+static void Test_CheckLayoutEqual(Test_Layout *other, Clay_RenderCommandArray renderCommands, const char *when) {
+    Clay_Context *context = Clay_GetCurrentContext();
+    CHECK(context->layoutElements.length == other->elementCount, "%s: %d elements against %d", when, context->layoutElements.length, other->elementCount);
+    for (int32_t i = 0; i < other->elementCount && i < context->layoutElements.length; ++i) {
+        Clay_Dimensions dimensions = context->layoutElements.internalArray[i].dimensions;
+        CHECK(memcmp(&dimensions, &other->dimensions[i], sizeof(Clay_Dimensions)) == 0, "%s: element %d is %fx%f against %fx%f", when, i,
+            dimensions.width, dimensions.height, other->dimensions[i].width, other->dimensions[i].height);
+    }
+    CHECK(renderCommands.length == other->commandCount, "%s: %d render commands against %d", when, renderCommands.length, other->commandCount);
+    for (int32_t i = 0; i < other->commandCount && i < renderCommands.length; ++i) {
+        CHECK(Test_RenderCommandsEqual(&renderCommands.internalArray[i], &other->commands[i]), "%s: render command %d differs", when, i);
+    }
+}
+
+// Lays out a frame, then lays the same frame out again from scratch and checks that both gave the same element sizes and
+// render commands
+static void Test_CheckMatchesFreshLayout(Clay_RenderCommandArray (*layOutFrame)(void), const char *when) {
+    Test_Layout layout = Test_CopyLayout(layOutFrame());
+    Test_ForgetPreviousLayout();
+    Test_CheckLayoutEqual(&layout, layOutFrame(), when);
+    Test_FreeLayout(&layout);
+}
+
+static int Test_Finish(const char *testName) {
+    CHECK(Test_errorCount == 0, "clay reported %d errors", Test_errorCount);
+    free(Test_arenaMemory);
+    Test_arenaMemory = NULL;
+    if (Test_failureCount > 0) {
+        fprintf(stderr, "%s: %d checks failed\n", testName, Test_failureCount);
+        return 1;
+    }
+    printf("%s: ok\n", testName);
+    return 0;
+}